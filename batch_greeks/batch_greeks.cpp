@@ -0,0 +1,191 @@
+#include "batch_greeks.h"
+#include "../bs_call_price_greeks/analytic_greeks.h"
+#include "../classical_forward_differences/classical_forward_differences.h"
+#include "../complex_step_differentation/complex_step_differentation.h"
+#include "../bs_call_price/bs_call_price.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+// Round n bytes up to a whole number of cache lines
+static inline std::size_t aligned_size(std::size_t bytes) {
+    return (bytes + GREEK_BUFFER_ALIGNMENT - 1) & ~(GREEK_BUFFER_ALIGNMENT - 1);
+}
+
+static inline bool is_aligned(const void* p) {
+    return (reinterpret_cast<std::uintptr_t>(p) & (GREEK_BUFFER_ALIGNMENT - 1)) == 0;
+}
+
+bool greek_arena_init(GreekArena& arena, std::size_t capacity) {
+    /**
+     * Allocates the arena's only block; everything handed out afterwards is
+     * a slice of it.
+     */
+    arena.raw = std::malloc(capacity + GREEK_BUFFER_ALIGNMENT - 1);
+    if (!arena.raw) {
+        arena.base = 0;
+        arena.capacity = arena.used = 0;
+        return false;
+    }
+    const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(arena.raw);
+    arena.base = reinterpret_cast<unsigned char*>(aligned_size(p));
+    arena.capacity = capacity;
+    arena.used = 0;
+    return true;
+}
+
+void greek_arena_attach(GreekArena& arena, void* memory, std::size_t capacity) {
+    const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(memory);
+    const std::size_t skip = aligned_size(p) - p;
+    arena.raw = 0;
+    arena.base = reinterpret_cast<unsigned char*>(p + skip);
+    arena.capacity = capacity > skip ? capacity - skip : 0;
+    arena.used = 0;
+}
+
+double* greek_arena_alloc(GreekArena& arena, std::size_t n) {
+    const std::size_t bytes = aligned_size(n * sizeof(double));
+    if (bytes > arena.capacity - arena.used) return 0;
+    double* slice = reinterpret_cast<double*>(arena.base + arena.used);
+    arena.used += bytes;
+    return slice;
+}
+
+void greek_arena_reset(GreekArena& arena) {
+    arena.used = 0;
+}
+
+void greek_arena_release(GreekArena& arena) {
+    std::free(arena.raw);
+    arena.raw = 0;
+    arena.base = 0;
+    arena.capacity = arena.used = 0;
+}
+
+std::size_t batch_buffer_bytes(std::size_t n, unsigned select) {
+    std::size_t arrays = 0;
+    for (unsigned bit = GREEK_SELECT_PRICE; bit <= GREEK_SELECT_VEGA; bit <<= 1) {
+        if (select & bit) ++arrays;
+    }
+    return arrays * aligned_size(n * sizeof(double));
+}
+
+bool batch_buffers_from_arena(GreekArena& arena, std::size_t n, unsigned select, BatchGreekBuffers& out) {
+    /**
+     * Fills out with arena slices for the selected arrays (others null).
+     * Fails without consuming the arena if there is not enough room.
+     */
+    if (batch_buffer_bytes(n, select) > arena.capacity - arena.used) return false;
+    out.price = (select & GREEK_SELECT_PRICE) ? greek_arena_alloc(arena, n) : 0;
+    out.delta = (select & GREEK_SELECT_DELTA) ? greek_arena_alloc(arena, n) : 0;
+    out.gamma = (select & GREEK_SELECT_GAMMA) ? greek_arena_alloc(arena, n) : 0;
+    out.vega = (select & GREEK_SELECT_VEGA) ? greek_arena_alloc(arena, n) : 0;
+    return true;
+}
+
+// Closed-form price, delta, gamma and vega sharing d1, φ(d1) and the discount factors
+static inline void analytic_greeks_into(const BSContract& c, unsigned select, std::size_t i,
+                                        const BatchGreekBuffers& out) {
+    const double DF = std::exp(-c.r * c.T);
+    const double DFq = std::exp(-c.q * c.T);
+    const double F = c.S * std::exp((c.r - c.q) * c.T);
+    const double sigmaT = c.sigma * std::sqrt(std::max(c.T, 0.0));
+
+    if (sigmaT == 0.0) {
+        if (select & GREEK_SELECT_PRICE) out.price[i] = DF * std::max(F - c.K, 0.0);
+        if (select & GREEK_SELECT_DELTA) out.delta[i] = DFq * (F > c.K ? 1.0 : 0.0);
+        if (select & GREEK_SELECT_GAMMA) out.gamma[i] = 0.0;
+        if (select & GREEK_SELECT_VEGA) out.vega[i] = 0.0;
+        return;
+    }
+
+    double ln_F_over_K;
+    if (c.K > 0.0) {
+        const double x = (F - c.K) / c.K;
+        ln_F_over_K = (std::abs(x) <= 1e-12) ? std::log1p(x) : std::log(F / c.K);
+    } else {
+        ln_F_over_K = std::log(F / c.K);
+    }
+
+    const double d1 = (ln_F_over_K + 0.5 * c.sigma * c.sigma * c.T) / sigmaT;
+
+    if (select & (GREEK_SELECT_PRICE | GREEK_SELECT_DELTA)) {
+        const double Phi_d1 = Phi_real(d1);
+        if (select & GREEK_SELECT_PRICE) out.price[i] = DF * (F * Phi_d1 - c.K * Phi_real(d1 - sigmaT));
+        if (select & GREEK_SELECT_DELTA) out.delta[i] = DFq * Phi_d1;
+    }
+    if (select & (GREEK_SELECT_GAMMA | GREEK_SELECT_VEGA)) {
+        const double DFq_phi = DFq * phi(d1);
+        if (select & GREEK_SELECT_GAMMA) out.gamma[i] = DFq_phi / (c.S * sigmaT);
+        if (select & GREEK_SELECT_VEGA) out.vega[i] = c.S * DFq_phi * std::sqrt(c.T);
+    }
+}
+
+bool evaluate_greeks_batch(const BSContract* contracts, std::size_t n, unsigned select,
+                           GreekMethod method, double h_rel, const BatchGreekBuffers& out) {
+    /**
+     * Hot path: no allocation, no string or stream work.
+     * Analytic: one fused pass computing the shared terms once per contract.
+     * Complex-step / forward-difference: one pass per selected Greek with
+     * steps h = h_rel·S for delta/gamma and h = h_rel·σ for vega; the price
+     * is always the closed form, and so are all Greeks of σ√T = 0 contracts.
+     *
+     * @param contracts Contracts to evaluate
+     * @param n         Number of contracts
+     * @param select    GreekSelect bits of the arrays to fill
+     * @param method    Method for delta, gamma and vega
+     * @param h_rel     Relative step for the numerical methods
+     * @param out       64-byte-aligned result arrays with n entries each
+     * @return          false if a selected buffer is null or misaligned
+     */
+    double* const buffers[] = {out.price, out.delta, out.gamma, out.vega};
+    for (int b = 0; b < 4; ++b) {
+        if ((select & (1u << b)) && (!buffers[b] || !is_aligned(buffers[b]))) return false;
+    }
+
+    if (method == GREEK_METHOD_ANALYTIC) {
+        for (std::size_t i = 0; i < n; ++i) analytic_greeks_into(contracts[i], select, i, out);
+        return true;
+    }
+
+    const bool cs = (method == GREEK_METHOD_COMPLEX_STEP);
+    if (select & GREEK_SELECT_PRICE) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const BSContract& c = contracts[i];
+            out.price[i] = bs_price_call(c.S, c.K, c.r, c.q, c.sigma, c.T);
+        }
+    }
+    if (select & GREEK_SELECT_DELTA) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const BSContract& c = contracts[i];
+            const double h = h_rel * c.S;
+            out.delta[i] = cs ? delta_complex_step(c.S, c.K, c.r, c.q, c.sigma, c.T, h)
+                              : delta_fwd(c.S, c.K, c.r, c.q, c.sigma, c.T, h);
+        }
+    }
+    if (select & GREEK_SELECT_GAMMA) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const BSContract& c = contracts[i];
+            const double h = h_rel * c.S;
+            out.gamma[i] = cs ? gamma_complex_step_45deg(c.S, c.K, c.r, c.q, c.sigma, c.T, h)
+                              : gamma_fwd(c.S, c.K, c.r, c.q, c.sigma, c.T, h);
+        }
+    }
+    if (select & GREEK_SELECT_VEGA) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const BSContract& c = contracts[i];
+            const double h = h_rel * c.sigma;
+            out.vega[i] = cs ? vega_complex_step(c.S, c.K, c.r, c.q, c.sigma, c.T, h)
+                             : vega_fwd(c.S, c.K, c.r, c.q, c.sigma, c.T, h);
+        }
+    }
+
+    // σ√T = 0: the vega step vanishes and the complex-step price has no
+    // derivative to carry, so take the closed-form zero-vol limits instead
+    for (std::size_t i = 0; i < n; ++i) {
+        const BSContract& c = contracts[i];
+        if (c.sigma * std::sqrt(std::max(c.T, 0.0)) == 0.0) analytic_greeks_into(c, select, i, out);
+    }
+    return true;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file batch_greeks.h
+ * @brief Allocation-free batch Greek evaluation into aligned caller buffers
+ *
+ * Evaluates price, delta, gamma and vega for a batch of contracts into
+ * structure-of-arrays result buffers chosen by a bitmask. Buffers are owned
+ * by the caller (any 64-byte-aligned memory) or carved from a GreekArena,
+ * which allocates one block up front and hands out aligned slices with a
+ * bump pointer. evaluate_greeks_batch itself never allocates.
+ */
+
+#ifndef BATCH_GREEKS_H
+#define BATCH_GREEKS_H
+
+#include "../greek_method_selection/greek_method_selection.h"
+#include <cstddef>
+
+// Greek selector bits
+enum GreekSelect {
+    GREEK_SELECT_PRICE = 1u << 0,
+    GREEK_SELECT_DELTA = 1u << 1,
+    GREEK_SELECT_GAMMA = 1u << 2,
+    GREEK_SELECT_VEGA = 1u << 3,
+    GREEK_SELECT_ALL = (1u << 4) - 1u
+};
+
+// Alignment required of every result buffer (one cache line)
+static const std::size_t GREEK_BUFFER_ALIGNMENT = 64;
+
+// Caller-owned result arrays, one entry per contract; only the selected
+// arrays are written and need to be non-null
+struct BatchGreekBuffers {
+    double* price;
+    double* delta;
+    double* gamma;
+    double* vega;
+};
+
+// Bump allocator over one 64-byte-aligned block
+struct GreekArena {
+    unsigned char* base;  // Aligned start of the usable block
+    void* raw;            // Owned allocation (null for attached memory)
+    std::size_t capacity;
+    std::size_t used;
+};
+
+// Allocate an owned block of at least capacity bytes
+bool greek_arena_init(GreekArena& arena, std::size_t capacity);
+
+// Use caller memory; base is aligned up, so capacity may shrink by up to 63 bytes
+void greek_arena_attach(GreekArena& arena, void* memory, std::size_t capacity);
+
+// Aligned array of n doubles, or null when the arena is full
+double* greek_arena_alloc(GreekArena& arena, std::size_t n);
+
+// Drop all slices, keep the block
+void greek_arena_reset(GreekArena& arena);
+
+// Free an owned block
+void greek_arena_release(GreekArena& arena);
+
+// Arena bytes needed for the selected result arrays of n contracts
+std::size_t batch_buffer_bytes(std::size_t n, unsigned select);
+
+// Carve the selected result arrays for n contracts from the arena
+bool batch_buffers_from_arena(GreekArena& arena, std::size_t n, unsigned select, BatchGreekBuffers& out);
+
+// Evaluate the selected Greeks with one method; returns false (without
+// writing) if a selected buffer is null or not 64-byte aligned
+bool evaluate_greeks_batch(const BSContract* contracts, std::size_t n, unsigned select,
+                           GreekMethod method, double h_rel, const BatchGreekBuffers& out);
+
+#endif // BATCH_GREEKS_H
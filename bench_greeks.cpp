@@ -0,0 +1,141 @@
+#include "bs_call_price_greeks/analytic_greeks.h"
+#include "classical_forward_differences/classical_forward_differences.h"
+#include "multicomplex_step/multicomplex_step.h"
+#include "delta_hedging/delta_hedging.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// Greek fields of BSCrossGreeks in declaration order
+static const char* const GREEK_NAMES[] = {"price", "delta", "vega", "gamma", "vanna",
+                                          "volga", "speed", "zomma", "dvanna_dvol", "ultima"};
+static const int NUM_GREEKS = 10;
+
+static double greek_at(const BSCrossGreeks& g, int i) {
+    const double values[] = {g.price, g.delta, g.vega, g.gamma, g.vanna,
+                             g.volga, g.speed, g.zomma, g.dvanna_dvol, g.ultima};
+    return values[i];
+}
+
+// Average ns per contract of one cross-Greek method over repeated calls
+template <typename Method>
+static double time_ns_per_contract(Method method, int reps) {
+    volatile double sink = 0.0;
+    const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < reps; ++rep) {
+        const BSCrossGreeks g = method(100.0 + 1e-3 * (rep % 7));
+        sink = sink + g.speed;
+    }
+    const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+}
+
+struct AnalyticMethod {
+    double K, r, q, sigma, T;
+    BSCrossGreeks operator()(double S) const { return bs_cross_greeks_call(S, K, r, q, sigma, T); }
+};
+
+struct MulticomplexMethod {
+    double K, r, q, sigma, T, h;
+    BSCrossGreeks operator()(double S) const { return cross_greeks_multicomplex(S, K, r, q, sigma, T, h); }
+};
+
+struct NestedFdMethod {
+    double K, r, q, sigma, T, h_rel;
+    BSCrossGreeks operator()(double S) const { return cross_greeks_fwd(S, K, r, q, sigma, T, h_rel * S, h_rel * sigma); }
+};
+
+static void bench_scenario(const char* name, double S, double K, double r, double q, double sigma, double T) {
+    const double h_mc = 1e-20;     // Multicomplex step: no cancellation, so tiny
+    const double h_rel_fd = 1e-3;  // Third-order forward differences: h ~ eps^{1/4}
+
+    const BSCrossGreeks analytic = bs_cross_greeks_call(S, K, r, q, sigma, T);
+    const BSCrossGreeks mc = cross_greeks_multicomplex(S, K, r, q, sigma, T, h_mc);
+    const BSCrossGreeks fd = cross_greeks_fwd(S, K, r, q, sigma, T, h_rel_fd * S, h_rel_fd * sigma);
+
+    std::cout << name << "\n";
+    std::cout << "  S = " << S << ", K = " << K << ", r = " << r << ", q = " << q
+              << ", σ = " << sigma << ", T = " << T << "\n";
+    std::cout << "  " << std::left << std::setw(12) << "Greek" << std::right
+              << std::setw(20) << "Analytic" << std::setw(18) << "rel_err_mc" << std::setw(18) << "rel_err_fd" << "\n";
+    std::cout << std::scientific << std::setprecision(6);
+    for (int i = 0; i < NUM_GREEKS; ++i) {
+        const double ref = greek_at(analytic, i);
+        const double scale = std::abs(ref) > 0.0 ? std::abs(ref) : 1.0;
+        std::cout << "  " << std::left << std::setw(12) << GREEK_NAMES[i] << std::right
+                  << std::setw(20) << ref
+                  << std::setw(18) << std::abs(greek_at(mc, i) - ref) / scale
+                  << std::setw(18) << std::abs(greek_at(fd, i) - ref) / scale << "\n";
+    }
+
+    const AnalyticMethod analytic_method = {K, r, q, sigma, T};
+    const MulticomplexMethod mc_method = {K, r, q, sigma, T, h_mc};
+    const NestedFdMethod fd_method = {K, r, q, sigma, T, h_rel_fd};
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  ns/contract (all 10 values): analytic " << time_ns_per_contract(analytic_method, 20000)
+              << ", multicomplex " << time_ns_per_contract(mc_method, 200)
+              << ", nested FD " << time_ns_per_contract(fd_method, 20000) << "\n\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+// Hedging error spread per delta method and rebalance frequency
+static void bench_hedging() {
+    // Strike ladder of sold calls plus a long wing, one underlier
+    std::vector<HedgedOption> book;
+    for (int i = 0; i < 10; ++i) {
+        HedgedOption option = {80.0 + 5.0 * i, 1.0 + 0.1 * i, 0.20, i == 9 ? 2.0 : -1.0};
+        book.push_back(option);
+    }
+
+    HedgeSimConfig config = default_hedge_config();
+    config.n_paths = 5000;
+
+    const GreekMethod methods[] = {GREEK_METHOD_ANALYTIC, GREEK_METHOD_FORWARD_DIFF, GREEK_METHOD_COMPLEX_STEP};
+    const char* const method_names[] = {"bs_delta_call", "delta_fwd", "delta_complex_step"};
+    const double h_rels[] = {0.0, 1e-8, 1e-6};
+    const int frequencies[] = {1, 5, 21};
+
+    std::cout << "Delta hedging: " << book.size() << " options, " << config.n_paths << " paths x "
+              << config.n_steps << " steps\n";
+    std::cout << "  " << std::left << std::setw(20) << "Delta method" << std::right << std::setw(10) << "rebal"
+              << std::setw(16) << "stdev" << std::setw(16) << "q01" << std::setw(16) << "q99"
+              << std::setw(18) << "ns/rebal/option" << "\n";
+    for (int m = 0; m < 3; ++m) {
+        for (int f = 0; f < 3; ++f) {
+            config.delta_method = methods[m];
+            config.h_rel = h_rels[m];
+            config.rebalance_every = frequencies[f];
+
+            HedgeSimResult result;
+            const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            simulate_delta_hedging(config, &book[0], book.size(), result);
+            const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+            const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+            const double rebalances = static_cast<double>(config.n_steps) / config.rebalance_every;
+
+            std::cout << "  " << std::left << std::setw(20) << method_names[m] << std::right
+                      << std::setw(10) << frequencies[f] << std::scientific << std::setprecision(4)
+                      << std::setw(16) << result.stdev << std::setw(16) << result.q01 << std::setw(16) << result.q99
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(18) << ns / (config.n_paths * rebalances * book.size()) << "\n";
+            std::cout.unsetf(std::ios::floatfield);
+            std::cout << std::setprecision(6);
+        }
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "=== Cross Greeks Benchmark: multicomplex vs nested FD vs analytic ===\n\n";
+
+    bench_scenario("Scenario 1 (ATM reference):", 100.0, 100.0, 0.0, 0.0, 0.20, 1.0);
+    bench_scenario("Scenario 2 (Near-expiry, low-vol, ATM):", 100.0, 100.0, 0.0, 0.0, 0.01, 1.0 / 365.0);
+    bench_scenario("Scenario 3 (OTM with rates and yield):", 100.0, 110.0, 0.03, 0.01, 0.25, 0.5);
+
+    bench_hedging();
+
+    return 0;
+}
@@ -77,3 +77,90 @@ double bs_gamma_call(double S, double K, double r, double q, double sigma, doubl
 
     return std::exp(-q * T) * phi_d1 / (S * sigmaT);
 }
+
+// Generic interface: returns delta, gamma or vega based on type parameter
+double bs_analytic_call(const std::string& type, double S, double K, double r, double q, double sigma, double T) {
+    /**
+     * Dispatches to the analytic Greek named by type.
+     * @param type  "delta", "gamma" or "vega"
+     * @return      The requested Greek, or NaN for an unknown type
+     */
+    if (type == "delta") return bs_delta_call(S, K, r, q, sigma, T);
+    if (type == "gamma") return bs_gamma_call(S, K, r, q, sigma, T);
+    if (type == "vega") return bs_vega_call(S, K, r, q, sigma, T);
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+// Black-Scholes call vega: ν = S e^{-qT} φ(d1) √T
+double bs_vega_call(double S, double K, double r, double q, double sigma, double T) {
+    /**
+     * Calculates the Black-Scholes vega for a European call option.
+     * @param S     Spot price
+     * @param K     Strike price
+     * @param r     Continuously compounded risk-free interest rate
+     * @param q     Continuous dividend yield
+     * @param sigma Annualized volatility
+     * @param T     Time to maturity
+     * @return      Vega of the call option (per unit of σ)
+     */
+    const double sigmaT = sigma * std::sqrt(std::max(T, 0.0));
+    if (sigmaT == 0.0) return 0.0;
+
+    const double F = S * std::exp((r - q) * T);
+
+    double ln_F_over_K;
+    if (K > 0.0) {
+        const double x = (F - K) / K;
+        ln_F_over_K = (std::abs(x) <= 1e-12) ? std::log1p(x) : std::log(F / K);
+    } else {
+        ln_F_over_K = std::log(F / K);
+    }
+
+    const double d1 = (ln_F_over_K + 0.5 * sigma * sigma * T) / sigmaT;
+    return S * std::exp(-q * T) * phi(d1) * std::sqrt(T);
+}
+
+// Closed-form price and all S/σ derivatives up to third order
+BSCrossGreeks bs_cross_greeks_call(double S, double K, double r, double q, double sigma, double T) {
+    /**
+     * Calculates price, delta, vega, gamma, vanna, volga, speed, zomma,
+     * ∂³C/∂S∂σ² and ultima from d1, d2 and φ(d1). Uses ∂d1/∂σ = -d2/σ
+     * and ∂d2/∂σ = -d1/σ.
+     * @param S     Spot price
+     * @param K     Strike price
+     * @param r     Continuously compounded risk-free interest rate
+     * @param q     Continuous dividend yield
+     * @param sigma Annualized volatility
+     * @param T     Time to maturity
+     * @return      All mixed S/σ derivatives up to third order
+     */
+    BSCrossGreeks g = {bs_price_call(S, K, r, q, sigma, T), bs_delta_call(S, K, r, q, sigma, T),
+                       0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    const double sigmaT = sigma * std::sqrt(std::max(T, 0.0));
+    if (sigmaT == 0.0) return g;
+
+    const double F = S * std::exp((r - q) * T);
+
+    double ln_F_over_K;
+    if (K > 0.0) {
+        const double x = (F - K) / K;
+        ln_F_over_K = (std::abs(x) <= 1e-12) ? std::log1p(x) : std::log(F / K);
+    } else {
+        ln_F_over_K = std::log(F / K);
+    }
+
+    const double d1 = (ln_F_over_K + 0.5 * sigma * sigma * T) / sigmaT;
+    const double d2 = d1 - sigmaT;
+    const double DFq_phi = std::exp(-q * T) * phi(d1);  // e^{-qT} φ(d1)
+
+    g.vega = S * DFq_phi * std::sqrt(T);
+    g.gamma = DFq_phi / (S * sigmaT);
+    g.vanna = -DFq_phi * d2 / sigma;
+    g.volga = g.vega * d1 * d2 / sigma;
+    g.speed = -g.gamma / S * (d1 / sigmaT + 1.0);
+    g.zomma = g.gamma * (d1 * d2 - 1.0) / sigma;
+    g.dvanna_dvol = DFq_phi * (d1 + d2 - d1 * d2 * d2) / (sigma * sigma);
+    g.ultima = -g.vega / (sigma * sigma) * (d1 * d2 * (1.0 - d1 * d2) + d1 * d1 + d2 * d2);
+    return g;
+}
@@ -2,8 +2,8 @@
  * @file analytic_greeks.h
  * @brief Analytic formulas for Black-Scholes Greeks
  *
- * Implements closed-form solutions for delta and gamma
- * of Black-Scholes European call options.
+ * Implements closed-form solutions for delta, gamma, vega and the
+ * higher-order S/σ sensitivities of Black-Scholes European call options.
  */
 
 #ifndef ANALYTIC_GREEKS_H
@@ -19,7 +19,27 @@ double bs_delta_call(double S, double K, double r, double q, double sigma, doubl
 // Black-Scholes call gamma: Γ = e^{-qT} φ(d1) / (S σ sqrt(T))
 double bs_gamma_call(double S, double K, double r, double q, double sigma, double T);
 
-// Generic interface: returns delta or gamma based on type parameter
-double bs_analytic_call(std::string type, double S, double K, double r, double q, double sigma, double T);
+// Price and all mixed S/σ derivatives up to third order
+struct BSCrossGreeks {
+    double price;
+    double delta;        // ∂C/∂S
+    double vega;         // ∂C/∂σ
+    double gamma;        // ∂²C/∂S²
+    double vanna;        // ∂²C/∂S∂σ
+    double volga;        // ∂²C/∂σ²
+    double speed;        // ∂³C/∂S³
+    double zomma;        // ∂³C/∂S²∂σ
+    double dvanna_dvol;  // ∂³C/∂S∂σ²
+    double ultima;       // ∂³C/∂σ³
+};
+
+// Black-Scholes call vega: ν = S e^{-qT} φ(d1) √T
+double bs_vega_call(double S, double K, double r, double q, double sigma, double T);
+
+// Closed-form price and all S/σ derivatives up to third order
+BSCrossGreeks bs_cross_greeks_call(double S, double K, double r, double q, double sigma, double T);
+
+// Generic interface: returns delta, gamma or vega based on type parameter ("delta", "gamma", "vega")
+double bs_analytic_call(const std::string& type, double S, double K, double r, double q, double sigma, double T);
 
 #endif // ANALYTIC_GREEKS_H
@@ -54,4 +54,70 @@ double gamma_fwd(double S, double K, double r, double q, double sigma, double T,
     const double C_S_plus_h = bs_price_call(S + h, K, r, q, sigma, T);
     const double C_S_plus_2h = bs_price_call(S + 2.0 * h, K, r, q, sigma, T);
     return (C_S_plus_2h - 2.0 * C_S_plus_h + C_S) / (h * h);
-}
\ No newline at end of file
+}
+
+// Forward difference approximation for vega: ν_fwd(σ; h) = [C(σ+h) - C(σ)] / h
+double vega_fwd(double S, double K, double r, double q, double sigma, double T, double h) {
+    /**
+     * Computes vega using classical forward difference in the volatility.
+     * ν_fwd(σ; h) = [C(σ+h) - C(σ)] / h
+     * where C(·) = bs_price_call(S, K, r, q, ·, T)
+     *
+     * @param S     Spot price
+     * @param K     Strike price
+     * @param r     Risk-free rate
+     * @param q     Dividend yield
+     * @param sigma Volatility
+     * @param T     Time to maturity
+     * @param h     Step size
+     * @return      Forward difference approximation of vega
+     */
+    const double C_sigma = bs_price_call(S, K, r, q, sigma, T);
+    const double C_sigma_plus_h = bs_price_call(S, K, r, q, sigma + h, T);
+    return (C_sigma_plus_h - C_sigma) / h;
+}
+
+// Nested forward differences for all S/σ derivatives up to third order
+BSCrossGreeks cross_greeks_fwd(double S, double K, double r, double q, double sigma, double T,
+                               double h_S, double h_sigma) {
+    /**
+     * Computes the mixed S/σ derivatives by stacking forward-difference bumps:
+     * Δ^a_S Δ^b_σ C = Σ_i Σ_j (-1)^{a-i+b-j} binom(a,i) binom(b,j) C(S + i h_S, σ + j h_σ)
+     * using the prices on the grid i + j ≤ 3.
+     *
+     * @param S       Spot price
+     * @param K       Strike price
+     * @param r       Risk-free rate
+     * @param q       Dividend yield
+     * @param sigma   Volatility
+     * @param T       Time to maturity
+     * @param h_S     Spot step size
+     * @param h_sigma Volatility step size
+     * @return        Forward difference approximations of all cross Greeks
+     */
+    double C[4][4];
+    for (int i = 0; i <= 3; ++i) {
+        for (int j = 0; i + j <= 3; ++j) {
+            C[i][j] = bs_price_call(S + i * h_S, K, r, q, sigma + j * h_sigma, T);
+        }
+    }
+
+    static const double binom[4][4] = {{1, 0, 0, 0}, {1, 1, 0, 0}, {1, 2, 1, 0}, {1, 3, 3, 1}};
+    double D[4][4];
+    for (int a = 0; a <= 3; ++a) {
+        for (int b = 0; a + b <= 3; ++b) {
+            double sum = 0.0;
+            for (int i = 0; i <= a; ++i) {
+                for (int j = 0; j <= b; ++j) {
+                    const double sign = ((a - i + b - j) % 2) ? -1.0 : 1.0;
+                    sum += sign * binom[a][i] * binom[b][j] * C[i][j];
+                }
+            }
+            D[a][b] = sum / (std::pow(h_S, a) * std::pow(h_sigma, b));
+        }
+    }
+
+    BSCrossGreeks g = {D[0][0], D[1][0], D[0][1], D[2][0], D[1][1],
+                       D[0][2], D[3][0], D[2][1], D[1][2], D[0][3]};
+    return g;
+}
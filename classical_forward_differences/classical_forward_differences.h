@@ -11,6 +11,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include "../bs_call_price_greeks/analytic_greeks.h"
 
 // Generic forward difference for first derivative
 double classical_forward_difference(double (*f)(double), double x, double h);
@@ -21,4 +22,12 @@ double delta_fwd(double S, double K, double r, double q, double sigma, double T,
 // Forward difference approximation for gamma: Γ_fwd(S; h) = [C(S+2h) - 2C(S+h) + C(S)] / h²
 double gamma_fwd(double S, double K, double r, double q, double sigma, double T, double h);
 
+// Forward difference approximation for vega: ν_fwd(σ; h) = [C(σ+h) - C(σ)] / h
+double vega_fwd(double S, double K, double r, double q, double sigma, double T, double h);
+
+// Nested forward differences for all S/σ derivatives up to third order:
+// ∂^a_S ∂^b_σ C ≈ Δ^a_S Δ^b_σ C / (h_S^a h_σ^b) on the 10-node grid a + b ≤ 3
+BSCrossGreeks cross_greeks_fwd(double S, double K, double r, double q, double sigma, double T,
+                               double h_S, double h_sigma);
+
 #endif // CLASSICAL_FORWARD_DIFFERENCES_H
@@ -162,3 +162,38 @@ double gamma_complex_step_45deg(double S, double K, double r, double q, double s
     double imag_sum = std::imag(f_plus + f_minus);
     return imag_sum / (h * h);
 }
+
+// Complex-step vega
+// ν ≈ Im[C(σ + ih)] / h
+// Truncation error: O(h²)
+double vega_complex_step(double S, double K, double r, double q, double sigma, double T, double h) {
+    /**
+     * Computes vega using complex-step differentiation in the volatility.
+     * Formula: ν ≈ Im[C(σ + ih)] / h
+     * where C(·) = bs_price_call(S, K, r, q, ·, T)
+     *
+     * @param S     Spot price
+     * @param K     Strike price
+     * @param r     Risk-free rate
+     * @param q     Dividend yield
+     * @param sigma Volatility
+     * @param T     Time to maturity
+     * @param h     Imaginary step size
+     * @return      Complex-step approximation of vega
+     */
+    
+    // Create complex volatility: σ + ih
+    std::complex<double> S_complex(S, 0.0);
+    std::complex<double> K_complex(K, 0.0);
+    std::complex<double> r_complex(r, 0.0);
+    std::complex<double> q_complex(q, 0.0);
+    std::complex<double> sigma_complex(sigma, h);
+    std::complex<double> T_complex(T, 0.0);
+    
+    // Evaluate price at σ + ih
+    std::complex<double> price_complex = bs_price_call_complex(
+        S_complex, K_complex, r_complex, q_complex, sigma_complex, T_complex);
+    
+    // Extract imaginary part and divide by h
+    return std::imag(price_complex) / h;
+}
@@ -26,4 +26,8 @@ double gamma_complex_step(double S, double K, double r, double q, double sigma,
 // Truncation error: O(h⁴)
 double gamma_complex_step_45deg(double S, double K, double r, double q, double sigma, double T, double h);
 
+// Complex-step vega: ν ≈ Im[C(σ + ih)] / h
+// Truncation error: O(h²)
+double vega_complex_step(double S, double K, double r, double q, double sigma, double T, double h);
+
 #endif // COMPLEX_STEP_H
@@ -0,0 +1,215 @@
+#include "delta_hedging.h"
+#include "../bs_call_price_greeks/analytic_greeks.h"
+#include "../classical_forward_differences/classical_forward_differences.h"
+#include "../complex_step_differentation/complex_step_differentation.h"
+#include "../bs_call_price/bs_call_price.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <thread>
+
+// Path-independent part of the analytic delta at one (step, contract):
+// Δ = dfq · Φ(a + b·log S). b = 0 marks the zero-vol case, where
+// Δ = dfq · 1{log S > a}.
+struct DeltaCoef {
+    double a;
+    double b;
+    double dfq;
+};
+
+HedgeSimConfig default_hedge_config() {
+    HedgeSimConfig config;
+    config.S0 = 100.0;
+    config.r = 0.0;
+    config.q = 0.0;
+    config.mu = 0.0;
+    config.realized_vol = 0.20;
+    config.horizon = 1.0;
+    config.n_steps = 252;
+    config.rebalance_every = 1;
+    config.n_paths = 10000;
+    config.seed = 42;
+    config.delta_method = GREEK_METHOD_ANALYTIC;
+    config.h_rel = 1e-6;
+    config.n_threads = 0;
+    config.replay_paths = 0;
+    return config;
+}
+
+// Analytic delta coefficients for every (step, contract), computed once and
+// shared by all paths and threads
+static std::vector<DeltaCoef> build_delta_coefficients(const HedgeSimConfig& cfg,
+                                                       const HedgedOption* book, std::size_t n) {
+    const double dt = cfg.horizon / cfg.n_steps;
+    std::vector<DeltaCoef> coef(static_cast<std::size_t>(cfg.n_steps) * n);
+    for (int s = 0; s < cfg.n_steps; ++s) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const double t_left = std::max(book[i].T - s * dt, 0.0);
+            const double sigmaT = book[i].sigma * std::sqrt(t_left);
+            DeltaCoef& c = coef[static_cast<std::size_t>(s) * n + i];
+            c.dfq = std::exp(-cfg.q * t_left);
+            if (sigmaT == 0.0) {
+                c.a = std::log(book[i].K) - (cfg.r - cfg.q) * t_left;
+                c.b = 0.0;
+            } else {
+                c.b = 1.0 / sigmaT;
+                c.a = ((cfg.r - cfg.q + 0.5 * book[i].sigma * book[i].sigma) * t_left - std::log(book[i].K)) * c.b;
+            }
+        }
+    }
+    return coef;
+}
+
+// Σ quantity · Δ_i at spot S and time t = step · dt
+static inline double book_delta(const HedgeSimConfig& cfg, const HedgedOption* book, std::size_t n,
+                                const DeltaCoef* coef_row, double S, double t) {
+    double total = 0.0;
+    if (cfg.delta_method == GREEK_METHOD_ANALYTIC) {
+        const double ln_S = std::log(S);
+        for (std::size_t i = 0; i < n; ++i) {
+            const DeltaCoef& c = coef_row[i];
+            const double delta = (c.b != 0.0) ? c.dfq * Phi_real(c.a + c.b * ln_S)
+                                              : (ln_S > c.a ? c.dfq : 0.0);
+            total += book[i].quantity * delta;
+        }
+        return total;
+    }
+
+    const double h = cfg.h_rel * S;  // Absolute step size: h = h_rel * S
+    for (std::size_t i = 0; i < n; ++i) {
+        const double tau = book[i].T - t;
+        const double delta = (cfg.delta_method == GREEK_METHOD_COMPLEX_STEP)
+                                 ? delta_complex_step(S, book[i].K, cfg.r, cfg.q, book[i].sigma, tau, h)
+                                 : delta_fwd(S, book[i].K, cfg.r, cfg.q, book[i].sigma, tau, h);
+        total += book[i].quantity * delta;
+    }
+    return total;
+}
+
+// Σ quantity · C_i at spot S with time t elapsed
+static inline double book_value(const HedgeSimConfig& cfg, const HedgedOption* book, std::size_t n,
+                                double S, double t) {
+    double total = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        total += book[i].quantity * bs_price_call(S, book[i].K, cfg.r, cfg.q, book[i].sigma, book[i].T - t);
+    }
+    return total;
+}
+
+// Simulate paths [begin, end) and write their hedging errors to pnl
+static void run_paths(const HedgeSimConfig& cfg, const HedgedOption* book, std::size_t n,
+                      const DeltaCoef* coef, std::size_t begin, std::size_t end, double* pnl) {
+    /**
+     * Self-financing hedged book started at zero value: buy the options,
+     * short their delta in the underlier, keep the rest in cash accruing at
+     * r, receive dividends on the shares. Everything below is stack or
+     * preallocated; nothing allocates inside the time loop.
+     */
+    const double dt = cfg.horizon / cfg.n_steps;
+    const double drift = (cfg.mu - 0.5 * cfg.realized_vol * cfg.realized_vol) * dt;
+    const double vol_sqrt_dt = cfg.realized_vol * std::sqrt(dt);
+    const double growth = std::exp(cfg.r * dt);
+    const double dividend = std::exp(cfg.q * dt) - 1.0;
+
+    for (std::size_t p = begin; p < end; ++p) {
+        // Per-path stream: results do not depend on the thread split
+        std::mt19937_64 rng(cfg.seed + 0x9E3779B97F4A7C15ULL * (p + 1));
+        std::normal_distribution<double> normal(0.0, 1.0);
+        const double* replay = cfg.replay_paths
+                                   ? cfg.replay_paths + p * static_cast<std::size_t>(cfg.n_steps + 1)
+                                   : 0;
+
+        double S = replay ? replay[0] : cfg.S0;
+        double shares = -book_delta(cfg, book, n, coef, S, 0.0);
+        double cash = -book_value(cfg, book, n, S, 0.0) - shares * S;
+
+        for (int s = 1; s <= cfg.n_steps; ++s) {
+            const double S_prev = S;
+            S = replay ? replay[s] : S * std::exp(drift + vol_sqrt_dt * normal(rng));
+            cash = cash * growth + shares * S_prev * dividend;
+
+            if (s < cfg.n_steps && s % cfg.rebalance_every == 0) {
+                const double new_shares = -book_delta(cfg, book, n, coef + static_cast<std::size_t>(s) * n, S, s * dt);
+                cash -= (new_shares - shares) * S;
+                shares = new_shares;
+            }
+        }
+
+        pnl[p] = cash + shares * S + book_value(cfg, book, n, S, cfg.horizon);
+    }
+}
+
+// Linearly interpolated quantile of sorted values
+static double sorted_quantile(const std::vector<double>& sorted, double prob) {
+    const double pos = prob * (sorted.size() - 1);
+    const std::size_t lo = static_cast<std::size_t>(pos);
+    const std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (pos - lo) * (sorted[hi] - sorted[lo]);
+}
+
+bool simulate_delta_hedging(const HedgeSimConfig& config, const HedgedOption* book, std::size_t n,
+                            HedgeSimResult& result) {
+    /**
+     * Runs the hedging backtest over all paths and summarizes the hedging
+     * error distribution.
+     *
+     * @param config Simulation setup (paths, frequency, delta method, ...)
+     * @param book   Options held; all must mature at or after the horizon
+     * @param n      Number of options in the book
+     * @param result Per-path hedging errors and their summary statistics
+     * @return       false if the configuration or the book is invalid
+     */
+    if (config.n_steps <= 0 || config.rebalance_every <= 0 || config.n_paths == 0 ||
+        !(config.horizon > 0.0) || n == 0 || (!config.replay_paths && !(config.S0 > 0.0))) {
+        std::cerr << "Error: Invalid delta-hedging configuration.\n";
+        return false;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (book[i].T < config.horizon || !(book[i].K > 0.0)) {
+            std::cerr << "Error: Option " << i << " must have K > 0 and mature at or after the horizon.\n";
+            return false;
+        }
+    }
+
+    const std::vector<DeltaCoef> coef = build_delta_coefficients(config, book, n);
+    result.pnl.assign(config.n_paths, 0.0);
+
+    std::size_t n_threads = config.n_threads > 0 ? static_cast<std::size_t>(config.n_threads)
+                                                 : std::max(1u, std::thread::hardware_concurrency());
+    n_threads = std::min(n_threads, config.n_paths);
+
+    // Contiguous path ranges, one per thread
+    std::vector<std::thread> workers;
+    const std::size_t chunk = (config.n_paths + n_threads - 1) / n_threads;
+    for (std::size_t w = 1; w < n_threads; ++w) {
+        const std::size_t begin = std::min(w * chunk, config.n_paths);
+        const std::size_t end = std::min(begin + chunk, config.n_paths);
+        workers.push_back(std::thread(run_paths, std::cref(config), book, n, &coef[0], begin, end, &result.pnl[0]));
+    }
+    run_paths(config, book, n, &coef[0], 0, std::min(chunk, config.n_paths), &result.pnl[0]);
+    for (std::size_t w = 0; w < workers.size(); ++w) workers[w].join();
+
+    // Summary statistics of the hedging error
+    double sum = 0.0;
+    for (std::size_t p = 0; p < config.n_paths; ++p) sum += result.pnl[p];
+    result.mean = sum / config.n_paths;
+
+    double sum_sq = 0.0;
+    for (std::size_t p = 0; p < config.n_paths; ++p) {
+        const double d = result.pnl[p] - result.mean;
+        sum_sq += d * d;
+    }
+    result.variance = config.n_paths > 1 ? sum_sq / (config.n_paths - 1) : 0.0;
+    result.stdev = std::sqrt(result.variance);
+
+    std::vector<double> sorted(result.pnl);
+    std::sort(sorted.begin(), sorted.end());
+    result.q01 = sorted_quantile(sorted, 0.01);
+    result.q05 = sorted_quantile(sorted, 0.05);
+    result.q50 = sorted_quantile(sorted, 0.50);
+    result.q95 = sorted_quantile(sorted, 0.95);
+    result.q99 = sorted_quantile(sorted, 0.99);
+    return true;
+}
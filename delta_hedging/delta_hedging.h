@@ -0,0 +1,65 @@
+/**
+ * @file delta_hedging.h
+ * @brief Delta-hedging backtest driven by the Greek engines
+ *
+ * Simulates a book of European calls on one underlier, delta-hedged with
+ * the underlier at a configurable rebalance frequency along GBM or
+ * replayed spot paths. Records the hedging error (terminal P&L of the
+ * self-financing hedged book) per path, so the P&L distribution can be
+ * compared across delta methods and rebalance frequencies.
+ *
+ * Paths run in parallel; each path draws from its own seeded generator,
+ * so results do not depend on the thread count. The time loop performs no
+ * heap allocation.
+ */
+
+#ifndef DELTA_HEDGING_H
+#define DELTA_HEDGING_H
+
+#include "../greek_method_selection/greek_method_selection.h"
+#include <cstddef>
+#include <vector>
+
+// One option position of the hedged book (calls on the common underlier)
+struct HedgedOption {
+    double K;         // Strike price
+    double T;         // Time to maturity at t = 0 (must be >= horizon)
+    double sigma;     // Implied volatility used for pricing and hedging
+    double quantity;  // Calls held (negative = sold)
+};
+
+// Simulation setup
+struct HedgeSimConfig {
+    double S0;                   // Initial spot (ignored for replayed paths)
+    double r;                    // Risk-free rate
+    double q;                    // Dividend yield
+    double mu;                   // GBM drift of the spot
+    double realized_vol;         // GBM volatility of the spot
+    double horizon;              // Simulated time span in years
+    int n_steps;                 // Time steps over the horizon
+    int rebalance_every;         // Steps between hedge rebalances
+    std::size_t n_paths;         // Number of paths
+    unsigned long long seed;     // Base seed; path p uses its own stream
+    GreekMethod delta_method;    // Method used for the hedge ratio
+    double h_rel;                // Relative step for FD / complex-step deltas
+    int n_threads;               // Worker threads (0 = hardware concurrency)
+    const double* replay_paths;  // Optional n_paths x (n_steps + 1) spots, row-major
+};
+
+// Hedging error distribution over paths
+struct HedgeSimResult {
+    std::vector<double> pnl;  // Terminal hedging error per path
+    double mean;
+    double variance;
+    double stdev;
+    double q01, q05, q50, q95, q99;  // Quantiles of the hedging error
+};
+
+// Defaults: ATM-ish daily steps over one year, analytic deltas
+HedgeSimConfig default_hedge_config();
+
+// Run the backtest; returns false (and reports to std::cerr) on invalid input
+bool simulate_delta_hedging(const HedgeSimConfig& config, const HedgedOption* book, std::size_t n,
+                            HedgeSimResult& result);
+
+#endif // DELTA_HEDGING_H
@@ -0,0 +1,403 @@
+#include "greek_method_selection.h"
+#include "../bs_call_price_greeks/analytic_greeks.h"
+#include "../classical_forward_differences/classical_forward_differences.h"
+#include "../complex_step_differentation/complex_step_differentation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+static const char* const METHOD_NAMES[GREEK_METHOD_COUNT] = {"analytic", "complex_step", "forward_diff"};
+static const char* const KIND_NAMES[GREEK_KIND_COUNT] = {"delta", "gamma"};
+
+// The first bucket is sampled over [LOWEST_SAMPLED_FRACTION·edges[0], edges[0]]
+static const double LOWEST_SAMPLED_FRACTION = 0.1;
+
+// Single-contract evaluation shared by the sweep and the batch kernel
+static inline double evaluate_greek(GreekKind kind, GreekMethod method, double h_rel,
+                                    const BSContract& c) {
+    // σ√T = 0: no smooth neighbourhood to step into; the closed form is the exact limit
+    if (c.sigma * std::sqrt(std::max(c.T, 0.0)) == 0.0) method = GREEK_METHOD_ANALYTIC;
+
+    const double h = h_rel * c.S;  // Absolute step size: h = h_rel * S
+    if (kind == GREEK_DELTA) {
+        switch (method) {
+            case GREEK_METHOD_COMPLEX_STEP: return delta_complex_step(c.S, c.K, c.r, c.q, c.sigma, c.T, h);
+            case GREEK_METHOD_FORWARD_DIFF: return delta_fwd(c.S, c.K, c.r, c.q, c.sigma, c.T, h);
+            default:                        return bs_delta_call(c.S, c.K, c.r, c.q, c.sigma, c.T);
+        }
+    }
+    switch (method) {
+        case GREEK_METHOD_COMPLEX_STEP: return gamma_complex_step_45deg(c.S, c.K, c.r, c.q, c.sigma, c.T, h);
+        case GREEK_METHOD_FORWARD_DIFF: return gamma_fwd(c.S, c.K, c.r, c.q, c.sigma, c.T, h);
+        default:                        return bs_gamma_call(c.S, c.K, c.r, c.q, c.sigma, c.T);
+    }
+}
+
+// Error scale making the target dimensionless: Δ as is, Γ as S·Γ
+static inline double error_scale(GreekKind kind, double S) {
+    return kind == GREEK_DELTA ? 1.0 : S;
+}
+
+std::vector<double> default_total_vol_edges() {
+    /**
+     * σ√T bucket edges: scenario 2 (σ = 0.01, T = 1/365) lands in the first
+     * bucket, scenario 1 (σ = 0.20, T = 1) in the 0.3 bucket.
+     */
+    const double edges[] = {1e-3, 3e-3, 1e-2, 3e-2, 0.1, 0.3, 1.0};
+    return std::vector<double>(edges, edges + sizeof(edges) / sizeof(edges[0]));
+}
+
+std::size_t total_vol_bucket(const CalibrationTable& table, double total_vol) {
+    const std::size_t n = table.total_vol_edges.size();
+    for (std::size_t b = 0; b < n; ++b) {
+        if (total_vol <= table.total_vol_edges[b]) return b;
+    }
+    return n - 1;
+}
+
+bool total_vol_calibrated(const CalibrationTable& table, double total_vol) {
+    /**
+     * σ√T = 0 counts as calibrated: every method evaluates it with the
+     * closed form, which is exact.
+     */
+    if (total_vol == 0.0) return true;
+    const std::vector<double>& edges = table.total_vol_edges;
+    return !edges.empty() && total_vol >= LOWEST_SAMPLED_FRACTION * edges[0] && total_vol <= edges.back();
+}
+
+std::size_t calibration_index(const CalibrationTable& table, GreekKind kind,
+                              std::size_t bucket, GreekMethod method) {
+    return (static_cast<std::size_t>(kind) * table.total_vol_edges.size() + bucket)
+           * GREEK_METHOD_COUNT + static_cast<std::size_t>(method);
+}
+
+// Representative contracts for a bucket: both σ√T edges, several σ levels
+// (T = (v/σ)²) and moneyness K = S·e^{zv} for z ∈ {-1, 0, 1}
+static std::vector<BSContract> bucket_samples(double v_lo, double v_hi) {
+    const double S = 100.0;
+    const double sigmas[] = {0.01, 0.20, 0.80};
+    const double zs[] = {-1.0, 0.0, 1.0};
+    const double vs[] = {v_lo, v_hi};
+
+    std::vector<BSContract> samples;
+    for (int iv = 0; iv < 2; ++iv) {
+        for (int is = 0; is < 3; ++is) {
+            const double T = (vs[iv] / sigmas[is]) * (vs[iv] / sigmas[is]);
+            for (int iz = 0; iz < 3; ++iz) {
+                BSContract c = {S, S * std::exp(zs[iz] * vs[iv]), 0.0, 0.0, sigmas[is], T};
+                samples.push_back(c);
+            }
+        }
+    }
+    return samples;
+}
+
+// Worst scaled error of (kind, method, h_rel) over the samples
+static double max_sample_error(GreekKind kind, GreekMethod method, double h_rel,
+                               const std::vector<BSContract>& samples,
+                               const std::vector<double>& reference) {
+    double worst = 0.0;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const double value = evaluate_greek(kind, method, h_rel, samples[i]);
+        double err = std::abs(value - reference[i]) * error_scale(kind, samples[i].S);
+        if (!(err == err)) err = std::numeric_limits<double>::infinity();  // NaN
+        if (err > worst) worst = err;
+    }
+    return worst;
+}
+
+// Measured cost per contract of (kind, method) on the samples
+static double time_method(GreekKind kind, GreekMethod method, double h_rel,
+                          const std::vector<BSContract>& samples) {
+    const int reps = 200;
+    volatile double sink = 0.0;
+    const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < reps; ++rep) {
+        double acc = 0.0;
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            acc += evaluate_greek(kind, method, h_rel, samples[i]);
+        }
+        sink = sink + acc;
+    }
+    const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    return ns / (static_cast<double>(reps) * samples.size());
+}
+
+// Bucket edges must be non-empty, positive and strictly ascending
+static bool valid_total_vol_edges(const std::vector<double>& edges) {
+    if (edges.empty() || !(edges[0] > 0.0)) return false;
+    for (std::size_t b = 1; b < edges.size(); ++b) {
+        if (!(edges[b] > edges[b - 1])) return false;
+    }
+    return true;
+}
+
+bool build_calibration_table(const std::vector<double>& total_vol_edges, CalibrationTable& table) {
+    /**
+     * Sweeps h_rel over the same logarithmic grid as write_scenario_csv
+     * ([10^-16, 10^-4], 24 points) for every σ√T bucket and keeps, per
+     * (Greek, method), the step with the smallest worst-case error against
+     * the analytic reference, together with its measured cost.
+     *
+     * @return false if the edges are empty, non-positive or not ascending
+     */
+    if (!valid_total_vol_edges(total_vol_edges)) {
+        std::cerr << "Error: Calibration edges must be non-empty, positive and strictly ascending.\n";
+        return false;
+    }
+
+    table.total_vol_edges = total_vol_edges;
+    table.entries.resize(GREEK_KIND_COUNT * total_vol_edges.size() * GREEK_METHOD_COUNT);
+
+    const int num_points = 24;
+    const double log_min = -16.0;  // 10^-16
+    const double log_max = -4.0;   // 10^-4
+
+    for (std::size_t b = 0; b < total_vol_edges.size(); ++b) {
+        const double v_hi = total_vol_edges[b];
+        const double v_lo = (b == 0) ? LOWEST_SAMPLED_FRACTION * v_hi : total_vol_edges[b - 1];
+        const std::vector<BSContract> samples = bucket_samples(v_lo, v_hi);
+
+        for (int k = 0; k < GREEK_KIND_COUNT; ++k) {
+            const GreekKind kind = static_cast<GreekKind>(k);
+
+            std::vector<double> reference(samples.size());
+            for (std::size_t i = 0; i < samples.size(); ++i) {
+                reference[i] = evaluate_greek(kind, GREEK_METHOD_ANALYTIC, 0.0, samples[i]);
+            }
+
+            for (int m = 0; m < GREEK_METHOD_COUNT; ++m) {
+                const GreekMethod method = static_cast<GreekMethod>(m);
+                MethodCalibration cal = {method, 0.0, 0.0, 0.0};
+
+                if (method != GREEK_METHOD_ANALYTIC) {
+                    cal.max_err = std::numeric_limits<double>::infinity();
+                    for (int i = 0; i < num_points; ++i) {
+                        const double log_h_rel = log_min + i * (log_max - log_min) / (num_points - 1);
+                        const double h_rel = std::pow(10.0, log_h_rel);
+                        const double err = max_sample_error(kind, method, h_rel, samples, reference);
+                        if (err < cal.max_err) {
+                            cal.max_err = err;
+                            cal.h_rel = h_rel;
+                        }
+                    }
+                }
+                cal.ns_per_eval = time_method(kind, method, cal.h_rel, samples);
+                table.entries[calibration_index(table, kind, b, method)] = cal;
+            }
+        }
+    }
+    return true;
+}
+
+bool write_calibration_csv(const std::string& filename, const CalibrationTable& table) {
+    /**
+     * One row per (Greek, bucket, method):
+     * greek,total_vol_upper,method,h_rel,max_err,ns_per_eval
+     */
+    std::ofstream csv(filename);
+    if (!csv.is_open()) {
+        std::cerr << "Error: Could not open " << filename << " for writing.\n";
+        return false;
+    }
+
+    csv << "greek,total_vol_upper,method,h_rel,max_err,ns_per_eval\n";
+    csv << std::scientific << std::setprecision(12);
+
+    for (int k = 0; k < GREEK_KIND_COUNT; ++k) {
+        for (std::size_t b = 0; b < table.total_vol_edges.size(); ++b) {
+            for (int m = 0; m < GREEK_METHOD_COUNT; ++m) {
+                const MethodCalibration& cal = table.entries[calibration_index(
+                    table, static_cast<GreekKind>(k), b, static_cast<GreekMethod>(m))];
+                csv << KIND_NAMES[k] << "," << table.total_vol_edges[b] << ","
+                    << METHOD_NAMES[m] << "," << cal.h_rel << "," << cal.max_err << ","
+                    << cal.ns_per_eval << "\n";
+            }
+        }
+    }
+
+    csv.close();
+    std::cout << "Written: " << filename << " (" << table.entries.size() << " calibration rows)\n";
+    return true;
+}
+
+// Position of name in names[0..count), or -1
+static int lookup_name(const std::string& name, const char* const* names, int count) {
+    for (int i = 0; i < count; ++i) {
+        if (name == names[i]) return i;
+    }
+    return -1;
+}
+
+bool read_calibration_csv(const std::string& filename, CalibrationTable& table) {
+    /**
+     * Loads a table written by write_calibration_csv. Rows must be in the
+     * order written: Greek-major, then bucket, then method.
+     */
+    std::ifstream csv(filename);
+    if (!csv.is_open()) {
+        std::cerr << "Error: Could not open " << filename << " for reading.\n";
+        return false;
+    }
+
+    std::vector<int> kinds;
+    std::vector<double> edges;
+    std::vector<MethodCalibration> rows;
+
+    std::string line;
+    std::getline(csv, line);  // Header
+    while (std::getline(csv, line)) {
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        std::string kind_name, edge, method_name, h_rel, max_err, ns;
+        std::getline(ss, kind_name, ',');
+        std::getline(ss, edge, ',');
+        std::getline(ss, method_name, ',');
+        std::getline(ss, h_rel, ',');
+        std::getline(ss, max_err, ',');
+        std::getline(ss, ns, ',');
+
+        const int k = lookup_name(kind_name, KIND_NAMES, GREEK_KIND_COUNT);
+        const int m = lookup_name(method_name, METHOD_NAMES, GREEK_METHOD_COUNT);
+        if (k < 0 || m < 0 || ns.empty()) {
+            std::cerr << "Error: Malformed calibration row in " << filename << ": " << line << "\n";
+            return false;
+        }
+
+        MethodCalibration cal = {static_cast<GreekMethod>(m), std::strtod(h_rel.c_str(), 0),
+                                 std::strtod(max_err.c_str(), 0), std::strtod(ns.c_str(), 0)};
+        rows.push_back(cal);
+        kinds.push_back(k);
+        if (k == 0 && m == 0) edges.push_back(std::strtod(edge.c_str(), 0));
+    }
+
+    CalibrationTable loaded;
+    loaded.total_vol_edges = edges;
+    if (edges.empty() || rows.size() != GREEK_KIND_COUNT * edges.size() * GREEK_METHOD_COUNT) {
+        std::cerr << "Error: Incomplete calibration table in " << filename << "\n";
+        return false;
+    }
+    if (!valid_total_vol_edges(edges)) {
+        std::cerr << "Error: Calibration edges out of order in " << filename << "\n";
+        return false;
+    }
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const std::size_t b = (i / GREEK_METHOD_COUNT) % edges.size();
+        if (calibration_index(loaded, static_cast<GreekKind>(kinds[i]), b, rows[i].method) != i) {
+            std::cerr << "Error: Calibration rows out of order in " << filename << "\n";
+            return false;
+        }
+    }
+    loaded.entries = rows;
+    table = loaded;
+    return true;
+}
+
+const MethodCalibration& select_greek_method(const CalibrationTable& table, GreekKind kind,
+                                             const BSContract& contract, double target,
+                                             unsigned allowed) {
+    /**
+     * Looks up the contract's σ√T bucket and returns the cheapest allowed
+     * method whose calibrated worst-case error meets the target. If no
+     * allowed method meets it, the most accurate allowed one is returned.
+     * Outside the calibrated σ√T range the nearest bucket's errors were never
+     * measured for this contract, so the most accurate allowed method is
+     * returned regardless of cost (analytic whenever it is allowed).
+     * An empty mask is treated as "all methods".
+     */
+    if ((allowed & GREEK_METHOD_MASK_ALL) == 0) allowed = GREEK_METHOD_MASK_ALL;
+
+    const double total_vol = contract.sigma * std::sqrt(std::max(contract.T, 0.0));
+    const std::size_t bucket = total_vol_bucket(table, total_vol);
+
+    const MethodCalibration* cheapest = 0;
+    const MethodCalibration* most_accurate = 0;
+    for (int m = 0; m < GREEK_METHOD_COUNT; ++m) {
+        if (!(allowed & (1u << m))) continue;
+        const MethodCalibration& cal =
+            table.entries[calibration_index(table, kind, bucket, static_cast<GreekMethod>(m))];
+        if (cal.max_err <= target && (!cheapest || cal.ns_per_eval < cheapest->ns_per_eval)) {
+            cheapest = &cal;
+        }
+        if (!most_accurate || cal.max_err < most_accurate->max_err) {
+            most_accurate = &cal;
+        }
+    }
+    if (!total_vol_calibrated(table, total_vol)) return *most_accurate;
+    return cheapest ? *cheapest : *most_accurate;
+}
+
+std::vector<MethodGroup> group_by_method(const CalibrationTable& table, GreekKind kind,
+                                         const BSContract* contracts, std::size_t n,
+                                         double target, unsigned allowed) {
+    /**
+     * Groups are keyed on (method, h_rel, calibrated); indices keep the
+     * input order within each group.
+     */
+    std::vector<MethodGroup> groups;
+    for (std::size_t i = 0; i < n; ++i) {
+        const BSContract& c = contracts[i];
+        const MethodCalibration& cal = select_greek_method(table, kind, c, target, allowed);
+        const bool calibrated = total_vol_calibrated(table, c.sigma * std::sqrt(std::max(c.T, 0.0)));
+
+        std::size_t g = 0;
+        while (g < groups.size() && !(groups[g].method == cal.method && groups[g].h_rel == cal.h_rel &&
+                                      groups[g].calibrated == calibrated)) {
+            ++g;
+        }
+        if (g == groups.size()) {
+            MethodGroup group;
+            group.method = cal.method;
+            group.h_rel = cal.h_rel;
+            group.calibrated = calibrated;
+            groups.push_back(group);
+        }
+        groups[g].indices.push_back(i);
+    }
+    return groups;
+}
+
+void evaluate_greek_batch(GreekKind kind, GreekMethod method, double h_rel,
+                          const BSContract* contracts, const std::size_t* indices,
+                          std::size_t n, double* out) {
+    /**
+     * Batch kernel for one (kind, method, h_rel) group. All contracts share
+     * the method, so the dispatch inside the loop is perfectly predicted.
+     * A null index list means the contiguous contracts 0..n-1.
+     */
+    if (!indices) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = evaluate_greek(kind, method, h_rel, contracts[i]);
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j = indices[i];
+        out[j] = evaluate_greek(kind, method, h_rel, contracts[j]);
+    }
+}
+
+std::vector<MethodGroup> dispatch_greeks(const CalibrationTable& table, GreekKind kind,
+                                         const BSContract* contracts, std::size_t n,
+                                         double target, double* out, unsigned allowed) {
+    /**
+     * Computes one Greek for a mixed book, each contract with the cheapest
+     * method meeting the target in its regime. Returns the groups used;
+     * groups with calibrated == false carry no accuracy guarantee.
+     */
+    std::vector<MethodGroup> groups = group_by_method(table, kind, contracts, n, target, allowed);
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        const MethodGroup& group = groups[g];
+        evaluate_greek_batch(kind, group.method, group.h_rel, contracts,
+                             group.indices.empty() ? 0 : &group.indices[0],
+                             group.indices.size(), out);
+    }
+    return groups;
+}
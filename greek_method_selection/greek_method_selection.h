@@ -0,0 +1,121 @@
+/**
+ * @file greek_method_selection.h
+ * @brief Regime-driven selection of the Greek computation method
+ *
+ * Picks, per contract, the cheapest of the analytic, complex-step and
+ * forward-difference methods that meets a requested accuracy target.
+ * The choice is driven by a calibration table built offline by a step-size
+ * sweep over total-volatility (σ√T) regimes, in the spirit of
+ * write_scenario_csv. Contracts are grouped by the chosen method so each
+ * group is still evaluated as one batch.
+ *
+ * Accuracy is measured as absolute error of Δ and of S·Γ, so the target is
+ * dimensionless and does not depend on the spot level.
+ */
+
+#ifndef GREEK_METHOD_SELECTION_H
+#define GREEK_METHOD_SELECTION_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Numerical methods available for each Greek
+enum GreekMethod {
+    GREEK_METHOD_ANALYTIC = 0,
+    GREEK_METHOD_COMPLEX_STEP = 1,   // Im-part for Δ, 45° step for Γ
+    GREEK_METHOD_FORWARD_DIFF = 2,
+    GREEK_METHOD_COUNT = 3
+};
+
+// Greeks covered by the selector
+enum GreekKind {
+    GREEK_DELTA = 0,
+    GREEK_GAMMA = 1,
+    GREEK_KIND_COUNT = 2
+};
+
+// Bitmask of allowed methods: 1u << GreekMethod
+static const unsigned GREEK_METHOD_MASK_ALL = (1u << GREEK_METHOD_COUNT) - 1u;
+
+// Black-Scholes call contract parameters
+struct BSContract {
+    double S;       // Spot price
+    double K;       // Strike price
+    double r;       // Risk-free rate
+    double q;       // Dividend yield
+    double sigma;   // Volatility
+    double T;       // Time to maturity
+};
+
+// Measured accuracy and cost of one method within one regime bucket
+struct MethodCalibration {
+    GreekMethod method;
+    double h_rel;        // Best relative step (0 for analytic)
+    double max_err;      // Worst error over the bucket's sample contracts
+    double ns_per_eval;  // Measured cost per contract
+};
+
+// Calibration table: one MethodCalibration per (Greek, σ√T bucket, method)
+struct CalibrationTable {
+    // Ascending upper edges of the σ√T buckets. The first bucket is sampled
+    // down to 0.1·edges[0]; values outside [0.1·edges[0], edges.back()] use
+    // the nearest bucket but are uncalibrated (see total_vol_calibrated)
+    std::vector<double> total_vol_edges;
+    // Flat storage indexed by calibration_index()
+    std::vector<MethodCalibration> entries;
+};
+
+// Contracts sharing one (method, h_rel) choice, evaluated as a batch
+struct MethodGroup {
+    GreekMethod method;
+    double h_rel;
+    bool calibrated;   // false: σ√T outside the swept range, target not guaranteed
+    std::vector<std::size_t> indices;
+};
+
+// Default σ√T bucket edges, spanning near-expiry/low-vol to long-dated
+std::vector<double> default_total_vol_edges();
+
+// Index of the bucket holding total volatility σ√T
+std::size_t total_vol_bucket(const CalibrationTable& table, double total_vol);
+
+// Whether σ√T lies in the range the sweep sampled (σ√T = 0 is exact via the closed form)
+bool total_vol_calibrated(const CalibrationTable& table, double total_vol);
+
+// Flat index of (kind, bucket, method) into table.entries
+std::size_t calibration_index(const CalibrationTable& table, GreekKind kind,
+                              std::size_t bucket, GreekMethod method);
+
+// Run the offline sweep: best step size, worst error and cost per regime
+bool build_calibration_table(const std::vector<double>& total_vol_edges, CalibrationTable& table);
+
+// Save / load a calibration table as CSV
+bool write_calibration_csv(const std::string& filename, const CalibrationTable& table);
+bool read_calibration_csv(const std::string& filename, CalibrationTable& table);
+
+// Cheapest allowed method meeting the target; most accurate one if none does
+// or if the contract's σ√T is uncalibrated
+const MethodCalibration& select_greek_method(const CalibrationTable& table, GreekKind kind,
+                                             const BSContract& contract, double target,
+                                             unsigned allowed = GREEK_METHOD_MASK_ALL);
+
+// Partition contracts into groups by selected method
+std::vector<MethodGroup> group_by_method(const CalibrationTable& table, GreekKind kind,
+                                         const BSContract* contracts, std::size_t n,
+                                         double target,
+                                         unsigned allowed = GREEK_METHOD_MASK_ALL);
+
+// Evaluate one Greek with a fixed method for the indexed contracts:
+// out[indices[i]] = Greek(contracts[indices[i]]); indices may be null for 0..n-1
+void evaluate_greek_batch(GreekKind kind, GreekMethod method, double h_rel,
+                          const BSContract* contracts, const std::size_t* indices,
+                          std::size_t n, double* out);
+
+// Select, group and evaluate: out[i] receives the Greek of contracts[i]
+std::vector<MethodGroup> dispatch_greeks(const CalibrationTable& table, GreekKind kind,
+                                         const BSContract* contracts, std::size_t n,
+                                         double target, double* out,
+                                         unsigned allowed = GREEK_METHOD_MASK_ALL);
+
+#endif // GREEK_METHOD_SELECTION_H
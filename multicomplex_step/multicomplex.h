@@ -0,0 +1,333 @@
+/**
+ * @file multicomplex.h
+ * @brief Multicomplex numbers for higher-order complex-step derivatives
+ *
+ * A multicomplex number of order N has N commuting imaginary units
+ * i_1..i_N with i_k² = -1 and 2^N real coefficients. Coefficient c[m]
+ * multiplies the product of the units whose bits are set in m
+ * (bit k-1 ↔ i_k), so c[0] is the real part.
+ *
+ * Perturbing x along h(i_1 + ... + i_n) gives f^(n)(x) ≈ c[2^n - 1] / h^n
+ * with O(h²) truncation error and no subtractive cancellation, so h can
+ * be taken as small as 1e-20.
+ *
+ * When every unit of a group carries the same step, coefficients only
+ * depend on how many units of each group they include.
+ * SymmetricMulticomplex stores just those values, e.g. 16 instead of 64
+ * for three spot and three volatility units.
+ */
+
+#ifndef MULTICOMPLEX_H
+#define MULTICOMPLEX_H
+
+#include <cmath>
+
+template <int N>
+struct Multicomplex {
+    static const int ORDER = N;
+    static const int SIZE = 1 << N;
+    double c[1 << N];
+};
+
+typedef Multicomplex<2> Bicomplex;
+typedef Multicomplex<3> Tricomplex;
+
+// Recursive product on raw coefficients: with z = a + i_N b, w = c + i_N d,
+// z·w = (ac - bd) + i_N (ad + bc). The three-multiplication variant is
+// avoided on purpose: its (a+b)(c+d) - ac - bd cancels the tiny
+// imaginary parts the complex step relies on.
+template <int N>
+struct multicomplex_kernel {
+    static void mul(const double* x, const double* y, double* out) {
+        const int H = 1 << (N - 1);
+        double ac[1 << (N - 1)], bd[1 << (N - 1)], ad[1 << (N - 1)], bc[1 << (N - 1)];
+        multicomplex_kernel<N - 1>::mul(x, y, ac);
+        multicomplex_kernel<N - 1>::mul(x + H, y + H, bd);
+        multicomplex_kernel<N - 1>::mul(x, y + H, ad);
+        multicomplex_kernel<N - 1>::mul(x + H, y, bc);
+        for (int k = 0; k < H; ++k) {
+            out[k] = ac[k] - bd[k];
+            out[H + k] = ad[k] + bc[k];
+        }
+    }
+};
+
+template <>
+struct multicomplex_kernel<0> {
+    static void mul(const double* x, const double* y, double* out) {
+        out[0] = x[0] * y[0];
+    }
+};
+
+// Real constant a in any multicomplex representation
+template <typename Z>
+inline Z mc_constant(double a) {
+    Z z;
+    z.c[0] = a;
+    for (int m = 1; m < Z::SIZE; ++m) z.c[m] = 0.0;
+    return z;
+}
+
+// Real constant a
+template <int N>
+inline Multicomplex<N> mc_real(double a) {
+    return mc_constant<Multicomplex<N> >(a);
+}
+
+// x + h·(sum of the units whose bits are set in unit_mask)
+template <int N>
+inline Multicomplex<N> mc_variable(double x, double h, unsigned unit_mask) {
+    Multicomplex<N> z = mc_real<N>(x);
+    for (int k = 0; k < N; ++k) {
+        if (unit_mask & (1u << k)) z.c[1 << k] = h;
+    }
+    return z;
+}
+
+template <int N>
+inline Multicomplex<N> operator+(const Multicomplex<N>& x, const Multicomplex<N>& y) {
+    Multicomplex<N> z;
+    for (int m = 0; m < Multicomplex<N>::SIZE; ++m) z.c[m] = x.c[m] + y.c[m];
+    return z;
+}
+
+template <int N>
+inline Multicomplex<N> operator-(const Multicomplex<N>& x, const Multicomplex<N>& y) {
+    Multicomplex<N> z;
+    for (int m = 0; m < Multicomplex<N>::SIZE; ++m) z.c[m] = x.c[m] - y.c[m];
+    return z;
+}
+
+template <int N>
+inline Multicomplex<N> operator+(const Multicomplex<N>& x, double a) {
+    Multicomplex<N> z = x;
+    z.c[0] += a;
+    return z;
+}
+
+template <int N>
+inline Multicomplex<N> operator*(const Multicomplex<N>& x, double a) {
+    Multicomplex<N> z;
+    for (int m = 0; m < Multicomplex<N>::SIZE; ++m) z.c[m] = x.c[m] * a;
+    return z;
+}
+
+template <int N>
+inline Multicomplex<N> operator*(double a, const Multicomplex<N>& x) {
+    return x * a;
+}
+
+template <int N>
+inline Multicomplex<N> operator*(const Multicomplex<N>& x, const Multicomplex<N>& y) {
+    Multicomplex<N> z;
+    multicomplex_kernel<N>::mul(x.c, y.c, z.c);
+    return z;
+}
+
+// Multicomplex number of order NS + NV whose first NS units share one
+// step and last NV units another. Coefficient c[a * (NV + 1) + b] is the
+// common coefficient of every unit product with a units of the first group
+// and b of the second. Sums, products and analytic functions of such
+// numbers keep that symmetry, so nothing is lost by storing one value each.
+template <int NS, int NV>
+struct SymmetricMulticomplex {
+    static const int ORDER = NS + NV;
+    static const int SIZE = (NS + 1) * (NV + 1);
+    double c[(NS + 1) * (NV + 1)];
+};
+
+// C(n, k) for the group sizes used here
+inline double mc_binomial(int n, int k) {
+    static const double PASCAL[7][7] = {
+        {1, 0, 0, 0, 0, 0, 0},   {1, 1, 0, 0, 0, 0, 0},    {1, 2, 1, 0, 0, 0, 0},
+        {1, 3, 3, 1, 0, 0, 0},   {1, 4, 6, 4, 1, 0, 0},    {1, 5, 10, 10, 5, 1, 0},
+        {1, 6, 15, 20, 15, 6, 1}};
+    return PASCAL[n][k];
+}
+
+// Product on symmetric coefficients. For an output basis element with A
+// units of the first group, a factor pair splits those A units i / A-i and
+// shares k of the NS-A remaining units, each shared unit squaring to -1.
+// Every term of the full 2^N product is counted once through the weight
+// C(A,i) C(NS-A,k) (-1)^k, and likewise in the second group. The weighted
+// terms (400 for NS = NV = 3, against 4096 for the full product) are
+// tabulated once per instantiation.
+template <int NS, int NV>
+struct symmetric_multicomplex_kernel {
+    // Σ_A (A+1)(n-A+1) = (n+1)(n+2)(n+3)/6 factor pairs per group of n units
+    static const int TERMS = (NS + 1) * (NS + 2) * (NS + 3) / 6 * ((NV + 1) * (NV + 2) * (NV + 3) / 6);
+
+    // Terms grouped by output coefficient: first[m]..first[m+1]-1 sum into out[m]
+    struct Table {
+        int first[(NS + 1) * (NV + 1) + 1], x[TERMS], y[TERMS];
+        double w[TERMS];
+
+        Table() {
+            const int W = NV + 1;
+            int t = 0;
+            for (int A = 0; A <= NS; ++A) {
+                for (int B = 0; B <= NV; ++B) {
+                    first[A * W + B] = t;
+                    for (int i = 0; i <= A; ++i) {
+                        for (int k = 0; k <= NS - A; ++k) {
+                            for (int j = 0; j <= B; ++j) {
+                                for (int l = 0; l <= NV - B; ++l) {
+                                    x[t] = (i + k) * W + j + l;
+                                    y[t] = (A - i + k) * W + B - j + l;
+                                    w[t] = mc_binomial(A, i) * mc_binomial(NS - A, k) * mc_binomial(B, j) *
+                                           mc_binomial(NV - B, l) * (((k + l) % 2) ? -1.0 : 1.0);
+                                    ++t;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            first[(NS + 1) * W] = t;
+        }
+    };
+
+    static void mul(const double* x, const double* y, double* out) {
+        static const Table table;
+        for (int m = 0; m < (NS + 1) * (NV + 1); ++m) {
+            double sum = 0.0;
+            for (int t = table.first[m]; t < table.first[m + 1]; ++t) sum += table.w[t] * (x[table.x[t]] * y[table.y[t]]);
+            out[m] = sum;
+        }
+    }
+};
+
+// x + h·(sum of the units of group 0 or group 1)
+template <int NS, int NV>
+inline SymmetricMulticomplex<NS, NV> mc_symmetric_variable(double x, double h, int group) {
+    SymmetricMulticomplex<NS, NV> z = mc_constant<SymmetricMulticomplex<NS, NV> >(x);
+    z.c[group == 0 ? NV + 1 : 1] = h;
+    return z;
+}
+
+template <int NS, int NV>
+inline SymmetricMulticomplex<NS, NV> operator+(const SymmetricMulticomplex<NS, NV>& x,
+                                               const SymmetricMulticomplex<NS, NV>& y) {
+    SymmetricMulticomplex<NS, NV> z;
+    for (int m = 0; m < SymmetricMulticomplex<NS, NV>::SIZE; ++m) z.c[m] = x.c[m] + y.c[m];
+    return z;
+}
+
+template <int NS, int NV>
+inline SymmetricMulticomplex<NS, NV> operator-(const SymmetricMulticomplex<NS, NV>& x,
+                                               const SymmetricMulticomplex<NS, NV>& y) {
+    SymmetricMulticomplex<NS, NV> z;
+    for (int m = 0; m < SymmetricMulticomplex<NS, NV>::SIZE; ++m) z.c[m] = x.c[m] - y.c[m];
+    return z;
+}
+
+template <int NS, int NV>
+inline SymmetricMulticomplex<NS, NV> operator+(const SymmetricMulticomplex<NS, NV>& x, double a) {
+    SymmetricMulticomplex<NS, NV> z = x;
+    z.c[0] += a;
+    return z;
+}
+
+template <int NS, int NV>
+inline SymmetricMulticomplex<NS, NV> operator*(const SymmetricMulticomplex<NS, NV>& x, double a) {
+    SymmetricMulticomplex<NS, NV> z;
+    for (int m = 0; m < SymmetricMulticomplex<NS, NV>::SIZE; ++m) z.c[m] = x.c[m] * a;
+    return z;
+}
+
+template <int NS, int NV>
+inline SymmetricMulticomplex<NS, NV> operator*(double a, const SymmetricMulticomplex<NS, NV>& x) {
+    return x * a;
+}
+
+template <int NS, int NV>
+inline SymmetricMulticomplex<NS, NV> operator*(const SymmetricMulticomplex<NS, NV>& x,
+                                               const SymmetricMulticomplex<NS, NV>& y) {
+    SymmetricMulticomplex<NS, NV> z;
+    symmetric_multicomplex_kernel<NS, NV>::mul(x.c, y.c, z.c);
+    return z;
+}
+
+// Analytic function of z = a + ε from its derivatives at the real part a:
+// f(z) = Σ_{k=0}^{N} f^(k)(a) ε^k / k!. Terms beyond ε^N only add O(h²)
+// relative corrections to coefficients already reached, matching the
+// truncation error of the multicomplex step itself.
+template <typename Z>
+inline Z mc_taylor(const Z& z, const double* derivs) {
+    const int N = Z::ORDER;
+    Z eps = z;
+    eps.c[0] = 0.0;
+
+    Z result = mc_constant<Z>(derivs[0]);
+    Z power = eps;
+    double inv_factorial = 1.0;
+    for (int k = 1; k <= N; ++k) {
+        inv_factorial /= k;
+        result = result + power * (derivs[k] * inv_factorial);
+        if (k < N) power = power * eps;
+    }
+    return result;
+}
+
+// e^z
+template <typename Z>
+inline Z mc_exp(const Z& z) {
+    double derivs[Z::ORDER + 1];
+    const double e = std::exp(z.c[0]);
+    for (int k = 0; k <= Z::ORDER; ++k) derivs[k] = e;
+    return mc_taylor(z, derivs);
+}
+
+// log z (real part must be positive)
+template <typename Z>
+inline Z mc_log(const Z& z) {
+    // d^k/da^k log a = (-1)^{k-1} (k-1)! / a^k
+    double derivs[Z::ORDER + 1];
+    const double a = z.c[0];
+    derivs[0] = std::log(a);
+    double term = 1.0 / a;
+    for (int k = 1; k <= Z::ORDER; ++k) {
+        derivs[k] = term;
+        term *= -static_cast<double>(k) / a;
+    }
+    return mc_taylor(z, derivs);
+}
+
+// 1 / z
+template <typename Z>
+inline Z mc_reciprocal(const Z& z) {
+    // d^k/da^k a^{-1} = (-1)^k k! / a^{k+1}
+    double derivs[Z::ORDER + 1];
+    const double a = z.c[0];
+    double term = 1.0 / a;
+    for (int k = 0; k <= Z::ORDER; ++k) {
+        derivs[k] = term;
+        term *= -static_cast<double>(k + 1) / a;
+    }
+    return mc_taylor(z, derivs);
+}
+
+// Φ(z): standard normal CDF, Φ^(k)(a) = (-1)^{k-1} He_{k-1}(a) φ(a)
+template <typename Z>
+inline Z mc_Phi(const Z& z) {
+    static constexpr double INV_SQRT_2 = 0.70710678118654752440;
+    static constexpr double INV_SQRT_2PI = 0.39894228040143267794;
+
+    double derivs[Z::ORDER + 1];
+    const double a = z.c[0];
+    const double phi_a = INV_SQRT_2PI * std::exp(-0.5 * a * a);
+    derivs[0] = 0.5 * std::erfc(-a * INV_SQRT_2);
+
+    // Probabilists' Hermite polynomials: He_{n+1} = a He_n - n He_{n-1}
+    double he_prev = 0.0, he = 1.0;
+    for (int k = 1; k <= Z::ORDER; ++k) {
+        const int n = k - 1;
+        derivs[k] = ((n % 2) ? -he : he) * phi_a;
+        const double he_next = a * he - n * he_prev;
+        he_prev = he;
+        he = he_next;
+    }
+    return mc_taylor(z, derivs);
+}
+
+#endif // MULTICOMPLEX_H
@@ -0,0 +1,69 @@
+#include "multicomplex_step.h"
+#include "../bs_call_price/bs_call_price.h"
+#include <cmath>
+
+// Units i_1..i_3 carry the spot step (group 0), i_4..i_6 the volatility
+// step (group 1); both groups share h, so the 64 coefficients reduce to 16
+typedef SymmetricMulticomplex<3, 3> CrossMulticomplex;
+
+BSCrossGreeks cross_greeks_multicomplex(double S, double K, double r, double q, double sigma, double T,
+                                        double h) {
+    /**
+     * Computes price and all mixed S/σ derivatives up to third order with a
+     * single order-6 multicomplex evaluation, carried in the symmetric
+     * 16-coefficient form.
+     * Formula: ∂^a_S ∂^b_σ C ≈ c[4a + b] / h^{a+b}
+     *
+     * @param S     Spot price
+     * @param K     Strike price
+     * @param r     Risk-free rate
+     * @param q     Dividend yield
+     * @param sigma Volatility
+     * @param T     Time to maturity
+     * @param h     Imaginary step size (e.g. 1e-20)
+     * @return      Multicomplex-step approximation of all cross Greeks
+     */
+
+    // The degenerate payoff branch has no smooth σ dependence
+    if (sigma * std::sqrt(std::max(T, 0.0)) == 0.0) {
+        return bs_cross_greeks_call(S, K, r, q, sigma, T);
+    }
+
+    const CrossMulticomplex S_mc = mc_symmetric_variable<3, 3>(S, h, 0);
+    const CrossMulticomplex sigma_mc = mc_symmetric_variable<3, 3>(sigma, h, 1);
+    const CrossMulticomplex price = bs_price_call_multicomplex(S_mc, K, r, q, sigma_mc, T);
+
+    double D[4][4];
+    double h_pow = 1.0;
+    for (int order = 0; order <= 3; ++order) {
+        for (int a = order; a >= 0; --a) {
+            D[a][order - a] = price.c[4 * a + order - a] / h_pow;
+        }
+        h_pow *= h;
+    }
+
+    BSCrossGreeks g = {D[0][0], D[1][0], D[0][1], D[2][0], D[1][1],
+                       D[0][2], D[3][0], D[2][1], D[1][2], D[0][3]};
+    return g;
+}
+
+double speed_multicomplex_step(double S, double K, double r, double q, double sigma, double T, double h) {
+    /**
+     * Computes speed (∂³C/∂S³) using tricomplex-step differentiation.
+     * Formula: ∂³C/∂S³ ≈ Im_{i_1 i_2 i_3}[C(S + h(i_1 + i_2 + i_3))] / h³
+     *
+     * @param S     Spot price
+     * @param K     Strike price
+     * @param r     Risk-free rate
+     * @param q     Dividend yield
+     * @param sigma Volatility
+     * @param T     Time to maturity
+     * @param h     Imaginary step size
+     * @return      Tricomplex-step approximation of speed
+     */
+    if (sigma * std::sqrt(std::max(T, 0.0)) == 0.0) return 0.0;
+
+    const Tricomplex S_tc = mc_variable<3>(S, h, 0x07u);
+    const Tricomplex price = bs_price_call_multicomplex(S_tc, K, r, q, mc_real<3>(sigma), T);
+    return price.c[0x07] / (h * h * h);
+}
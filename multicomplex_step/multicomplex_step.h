@@ -0,0 +1,46 @@
+/**
+ * @file multicomplex_step.h
+ * @brief Multicomplex-step differentiation for third-order and cross Greeks
+ *
+ * Extends the complex-step idea to several imaginary units: with S perturbed
+ * along h(i_1 + i_2 + i_3) and σ along h(i_4 + i_5 + i_6), one evaluation of
+ * the multicomplex price yields every mixed S/σ derivative up to third order
+ * (speed, vanna, volga, zomma, ...) without subtractive cancellation.
+ */
+
+#ifndef MULTICOMPLEX_STEP_H
+#define MULTICOMPLEX_STEP_H
+
+#include "multicomplex.h"
+#include "../bs_call_price_greeks/analytic_greeks.h"
+#include <cmath>
+
+// Black-Scholes call price with multicomplex spot and volatility, in either
+// the full or the symmetric representation; K, r, q and T stay real.
+// Requires σ√T > 0.
+template <typename Z>
+Z bs_price_call_multicomplex(const Z& S, double K, double r, double q, const Z& sigma, double T) {
+    const double DF = std::exp(-r * T);
+    const double growth = std::exp((r - q) * T);  // F = S e^{(r-q)T}
+    const double sqrtT = std::sqrt(T);
+
+    // d1 = (log(F/K) + σ²T/2) / (σ√T), d2 = d1 - σ√T
+    const Z F = S * growth;
+    const Z ln_F_over_K = mc_log(F * (1.0 / K));
+    const Z d1 = (ln_F_over_K + sigma * sigma * (0.5 * T)) * mc_reciprocal(sigma) * (1.0 / sqrtT);
+    const Z d2 = d1 - sigma * sqrtT;
+
+    return (F * mc_Phi(d1) - mc_Phi(d2) * K) * DF;
+}
+
+// All mixed S/σ derivatives up to third order from one order-6 multicomplex evaluation
+// ∂^a_S ∂^b_σ C ≈ Im_{i_1..i_a i_4..i_{3+b}}[C(S + h(i_1+i_2+i_3), σ + h(i_4+i_5+i_6))] / h^{a+b}
+// Truncation error: O(h²)
+BSCrossGreeks cross_greeks_multicomplex(double S, double K, double r, double q, double sigma, double T,
+                                        double h);
+
+// Tricomplex-step third derivative in spot: ∂³C/∂S³ ≈ Im_{i_1 i_2 i_3}[C(S + h(i_1+i_2+i_3))] / h³
+// Truncation error: O(h²)
+double speed_multicomplex_step(double S, double K, double r, double q, double sigma, double T, double h);
+
+#endif // MULTICOMPLEX_STEP_H
@@ -0,0 +1,315 @@
+#include "sharded_greeks.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Request sent to a worker, followed by n BSContract records
+struct ShardRequestHeader {
+    std::uint64_t n;
+    std::uint32_t select;
+    std::int32_t method;
+    double h_rel;
+};
+
+// Reply status, followed by the selected result arrays (price, delta, gamma, vega order)
+struct ShardReplyHeader {
+    std::int32_t ok;
+};
+
+// Send all bytes; MSG_NOSIGNAL turns a dead peer into an error instead of SIGPIPE
+static bool write_all(int fd, const void* data, std::size_t bytes) {
+    const char* p = static_cast<const char*>(data);
+    while (bytes > 0) {
+        const ssize_t sent = send(fd, p, bytes, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += sent;
+        bytes -= static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+// Read exactly bytes: 1 on success, 0 on clean EOF before any byte, -1 otherwise
+static int read_exact(int fd, void* data, std::size_t bytes) {
+    char* p = static_cast<char*>(data);
+    std::size_t got = 0;
+    while (got < bytes) {
+        const ssize_t n = recv(fd, p + got, bytes - got, 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (n == 0) return got == 0 ? 0 : -1;
+        got += static_cast<std::size_t>(n);
+    }
+    return 1;
+}
+
+// Selected result arrays in wire order
+static int selected_arrays(unsigned select, const BatchGreekBuffers& buffers, double** arrays) {
+    double* const all[] = {buffers.price, buffers.delta, buffers.gamma, buffers.vega};
+    int count = 0;
+    for (int b = 0; b < 4; ++b) {
+        if (select & (1u << b)) arrays[count++] = all[b];
+    }
+    return count;
+}
+
+// (underlier, expiry) ordering used to form shard groups
+struct GroupKeyLess {
+    const BookEntry* book;
+    bool operator()(std::size_t a, std::size_t b) const {
+        if (book[a].underlier != book[b].underlier) return book[a].underlier < book[b].underlier;
+        return book[a].contract.T < book[b].contract.T;
+    }
+};
+
+// Orders group ids by descending group size
+struct GroupSizeGreater {
+    const std::vector<std::pair<std::size_t, std::size_t> >* groups;
+    bool operator()(std::size_t a, std::size_t b) const {
+        return (*groups)[a].second > (*groups)[b].second;
+    }
+};
+
+std::vector<Shard> shard_book(const BookEntry* book, std::size_t n, int n_shards) {
+    /**
+     * Contracts sharing an underlier and expiry stay in one shard, contiguous
+     * and in book order, so a worker sees each (spot, rate, expiry) group as
+     * one run. Groups are placed largest first on the least-loaded shard.
+     * Empty shards are dropped.
+     */
+    std::vector<std::size_t> order(n);
+    for (std::size_t i = 0; i < n; ++i) order[i] = i;
+    GroupKeyLess less = {book};
+    std::stable_sort(order.begin(), order.end(), less);
+
+    // Group boundaries in the sorted order: (begin, size)
+    std::vector<std::pair<std::size_t, std::size_t> > groups;
+    for (std::size_t i = 0; i < n;) {
+        std::size_t j = i + 1;
+        while (j < n && !less(order[i], order[j])) ++j;
+        groups.push_back(std::make_pair(i, j - i));
+        i = j;
+    }
+
+    // Largest first; ties keep key order
+    std::vector<std::size_t> by_size(groups.size());
+    for (std::size_t g = 0; g < groups.size(); ++g) by_size[g] = g;
+    GroupSizeGreater greater = {&groups};
+    std::stable_sort(by_size.begin(), by_size.end(), greater);
+
+    std::vector<Shard> shards(static_cast<std::size_t>(std::max(n_shards, 1)));
+    for (std::size_t a = 0; a < by_size.size(); ++a) {
+        const std::pair<std::size_t, std::size_t>& group = groups[by_size[a]];
+        std::size_t target = 0;
+        for (std::size_t s = 1; s < shards.size(); ++s) {
+            if (shards[s].indices.size() < shards[target].indices.size()) target = s;
+        }
+        for (std::size_t k = 0; k < group.second; ++k) {
+            shards[target].indices.push_back(order[group.first + k]);
+        }
+    }
+
+    std::vector<Shard> non_empty;
+    for (std::size_t s = 0; s < shards.size(); ++s) {
+        if (!shards[s].indices.empty()) non_empty.push_back(shards[s]);
+    }
+    return non_empty;
+}
+
+bool run_greeks_worker(int fd) {
+    /**
+     * Serves requests until the coordinator closes the socket. Each request
+     * is evaluated with evaluate_greeks_batch into arena buffers.
+     *
+     * @param fd Connected socket to the coordinator
+     * @return   true on clean shutdown, false on a protocol or I/O error
+     */
+    for (;;) {
+        ShardRequestHeader header;
+        const int status = read_exact(fd, &header, sizeof(header));
+        if (status == 0) return true;
+        if (status < 0) return false;
+
+        const std::size_t n = static_cast<std::size_t>(header.n);
+        std::vector<BSContract> contracts(n);
+        if (n > 0 && read_exact(fd, &contracts[0], n * sizeof(BSContract)) != 1) return false;
+
+        GreekArena arena;
+        const unsigned select = header.select & GREEK_SELECT_ALL;
+        BatchGreekBuffers results = {0, 0, 0, 0};
+        ShardReplyHeader reply = {0};
+        if (greek_arena_init(arena, batch_buffer_bytes(n, select)) &&
+            batch_buffers_from_arena(arena, n, select, results) &&
+            (n == 0 || evaluate_greeks_batch(&contracts[0], n, select,
+                                             static_cast<GreekMethod>(header.method), header.h_rel, results))) {
+            reply.ok = 1;
+        }
+
+        bool sent = write_all(fd, &reply, sizeof(reply));
+        if (reply.ok) {
+            double* arrays[4];
+            const int count = selected_arrays(select, results, arrays);
+            for (int a = 0; a < count && sent; ++a) sent = write_all(fd, arrays[a], n * sizeof(double));
+        }
+        greek_arena_release(arena);
+        if (!sent) return false;
+    }
+}
+
+bool start_worker_pool(GreekWorkerPool& pool, int n_workers) {
+    /**
+     * Forks the workers. Each child keeps only its own socket, serves
+     * requests and exits when the coordinator closes it.
+     */
+    for (int w = 0; w < n_workers; ++w) {
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+            std::cerr << "Error: socketpair failed for worker " << w << ".\n";
+            stop_worker_pool(pool);
+            return false;
+        }
+
+        const pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "Error: fork failed for worker " << w << ".\n";
+            close(sv[0]);
+            close(sv[1]);
+            stop_worker_pool(pool);
+            return false;
+        }
+        if (pid == 0) {
+            close(sv[0]);
+            for (std::size_t i = 0; i < pool.fds.size(); ++i) close(pool.fds[i]);
+            const bool ok = run_greeks_worker(sv[1]);
+            close(sv[1]);
+            _exit(ok ? 0 : 1);
+        }
+
+        close(sv[1]);
+        pool.fds.push_back(sv[0]);
+        pool.pids.push_back(pid);
+    }
+    return true;
+}
+
+void stop_worker_pool(GreekWorkerPool& pool) {
+    for (std::size_t i = 0; i < pool.fds.size(); ++i) close(pool.fds[i]);
+    for (std::size_t i = 0; i < pool.pids.size(); ++i) {
+        int status = 0;
+        while (waitpid(pool.pids[i], &status, 0) < 0 && errno == EINTR) {
+        }
+    }
+    pool.fds.clear();
+    pool.pids.clear();
+}
+
+std::vector<UnderlierRisk> aggregate_risk(const BookEntry* book, std::size_t n, unsigned select,
+                                          const BatchGreekBuffers& results) {
+    /**
+     * Sums quantity · Greek per underlier, visiting the book in order so the
+     * floating-point sums do not depend on how the book was sharded.
+     * Underliers are returned in ascending id order.
+     */
+    std::vector<int> ids;
+    for (std::size_t i = 0; i < n; ++i) ids.push_back(book[i].underlier);
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    std::vector<UnderlierRisk> risk(ids.size());
+    for (std::size_t u = 0; u < ids.size(); ++u) {
+        UnderlierRisk zero = {ids[u], 0.0, 0.0, 0.0, 0.0};
+        risk[u] = zero;
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t u = std::lower_bound(ids.begin(), ids.end(), book[i].underlier) - ids.begin();
+        const double qty = book[i].quantity;
+        if (select & GREEK_SELECT_PRICE) risk[u].pv += qty * results.price[i];
+        if (select & GREEK_SELECT_DELTA) risk[u].delta += qty * results.delta[i];
+        if (select & GREEK_SELECT_GAMMA) risk[u].gamma += qty * results.gamma[i];
+        if (select & GREEK_SELECT_VEGA) risk[u].vega += qty * results.vega[i];
+    }
+    return risk;
+}
+
+bool evaluate_book_local(const BookEntry* book, std::size_t n, unsigned select, GreekMethod method,
+                         double h_rel, const BatchGreekBuffers& out, std::vector<UnderlierRisk>& risk) {
+    /**
+     * Single-process reference for evaluate_book_sharded. out must hold n
+     * entries per selected Greek, 64-byte aligned.
+     */
+    std::vector<BSContract> contracts(n);
+    for (std::size_t i = 0; i < n; ++i) contracts[i] = book[i].contract;
+    if (n > 0 && !evaluate_greeks_batch(&contracts[0], n, select, method, h_rel, out)) return false;
+    risk = aggregate_risk(book, n, select, out);
+    return true;
+}
+
+bool evaluate_book_sharded(GreekWorkerPool& pool, const BookEntry* book, std::size_t n, unsigned select,
+                           GreekMethod method, double h_rel, const BatchGreekBuffers& out,
+                           std::vector<UnderlierRisk>& risk) {
+    /**
+     * Sends every shard before reading any reply, so all workers compute
+     * concurrently; replies are then read in shard order and scattered back
+     * to book positions.
+     *
+     * @return false on an I/O error or a failed worker evaluation
+     */
+    select &= GREEK_SELECT_ALL;
+    double* out_arrays[4];
+    const int count = selected_arrays(select, out, out_arrays);
+    for (int a = 0; a < count; ++a) {
+        if (!out_arrays[a]) {
+            std::cerr << "Error: Missing result buffer for a selected Greek.\n";
+            return false;
+        }
+    }
+    if (pool.fds.empty()) {
+        std::cerr << "Error: Worker pool is empty.\n";
+        return false;
+    }
+
+    const std::vector<Shard> shards = shard_book(book, n, static_cast<int>(pool.fds.size()));
+
+    for (std::size_t s = 0; s < shards.size(); ++s) {
+        const std::vector<std::size_t>& idx = shards[s].indices;
+        std::vector<BSContract> contracts(idx.size());
+        for (std::size_t i = 0; i < idx.size(); ++i) contracts[i] = book[idx[i]].contract;
+
+        ShardRequestHeader header = {idx.size(), select, static_cast<std::int32_t>(method), h_rel};
+        if (!write_all(pool.fds[s], &header, sizeof(header)) ||
+            !write_all(pool.fds[s], &contracts[0], contracts.size() * sizeof(BSContract))) {
+            std::cerr << "Error: Failed to send shard " << s << " to its worker.\n";
+            return false;
+        }
+    }
+
+    std::vector<double> values;
+    for (std::size_t s = 0; s < shards.size(); ++s) {
+        const std::vector<std::size_t>& idx = shards[s].indices;
+        ShardReplyHeader reply;
+        if (read_exact(pool.fds[s], &reply, sizeof(reply)) != 1 || !reply.ok) {
+            std::cerr << "Error: Worker for shard " << s << " failed.\n";
+            return false;
+        }
+        values.resize(idx.size());
+        for (int a = 0; a < count; ++a) {
+            if (read_exact(pool.fds[s], &values[0], idx.size() * sizeof(double)) != 1) {
+                std::cerr << "Error: Truncated results from worker for shard " << s << ".\n";
+                return false;
+            }
+            for (std::size_t i = 0; i < idx.size(); ++i) out_arrays[a][idx[i]] = values[i];
+        }
+    }
+
+    risk = aggregate_risk(book, n, select, out);
+    return true;
+}
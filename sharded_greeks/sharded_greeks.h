@@ -0,0 +1,80 @@
+/**
+ * @file sharded_greeks.h
+ * @brief Coordinator/worker evaluation of large books across processes
+ *
+ * The coordinator splits a book into shards that keep every
+ * (underlier, expiry) group together, sends each shard to a local worker
+ * process over a Unix socket, scatters the per-contract Greeks back into
+ * book order and aggregates the risk per underlier. Workers run the batch
+ * Greek kernels (evaluate_greeks_batch).
+ *
+ * Aggregation always happens in the coordinator in book order, so the
+ * merged results are bit-identical to a single-process run.
+ *
+ * POSIX only (fork, socketpair). Start the worker pool before spawning
+ * threads in the coordinator.
+ */
+
+#ifndef SHARDED_GREEKS_H
+#define SHARDED_GREEKS_H
+
+#include "../batch_greeks/batch_greeks.h"
+#include <cstddef>
+#include <sys/types.h>
+#include <vector>
+
+// One position of the book
+struct BookEntry {
+    int underlier;        // Underlier identifier
+    BSContract contract;  // Contract terms and market data
+    double quantity;      // Position size
+};
+
+// Book indices evaluated by one worker
+struct Shard {
+    std::vector<std::size_t> indices;
+};
+
+// Quantity-weighted risk of one underlier (unselected Greeks stay 0)
+struct UnderlierRisk {
+    int underlier;
+    double pv;
+    double delta;
+    double gamma;
+    double vega;
+};
+
+// Local worker processes, one socket each
+struct GreekWorkerPool {
+    std::vector<int> fds;
+    std::vector<pid_t> pids;
+};
+
+// Split the book into at most n_shards shards by (underlier, expiry) group,
+// largest groups first onto the least-loaded shard
+std::vector<Shard> shard_book(const BookEntry* book, std::size_t n, int n_shards);
+
+// Fork n_workers local workers connected by socketpairs
+bool start_worker_pool(GreekWorkerPool& pool, int n_workers);
+
+// Close the sockets and reap the workers
+void stop_worker_pool(GreekWorkerPool& pool);
+
+// Worker loop: serve batch requests on fd until the coordinator closes it
+bool run_greeks_worker(int fd);
+
+// Per-underlier risk from per-contract results, summed in book order
+std::vector<UnderlierRisk> aggregate_risk(const BookEntry* book, std::size_t n, unsigned select,
+                                          const BatchGreekBuffers& results);
+
+// Single-process reference: evaluate the whole book and aggregate
+bool evaluate_book_local(const BookEntry* book, std::size_t n, unsigned select, GreekMethod method,
+                         double h_rel, const BatchGreekBuffers& out, std::vector<UnderlierRisk>& risk);
+
+// Sharded run on the pool: shard, evaluate in workers, merge and aggregate.
+// After a false return the pool's sockets may hold stale replies; restart it.
+bool evaluate_book_sharded(GreekWorkerPool& pool, const BookEntry* book, std::size_t n, unsigned select,
+                           GreekMethod method, double h_rel, const BatchGreekBuffers& out,
+                           std::vector<UnderlierRisk>& risk);
+
+#endif // SHARDED_GREEKS_H
@@ -0,0 +1,181 @@
+#include "../batch_greeks/batch_greeks.h"
+#include "../bs_call_price_greeks/analytic_greeks.h"
+#include "../bs_call_price/bs_call_price.h"
+#include "../complex_step_differentation/complex_step_differentation.h"
+#include <iostream>
+#include <cmath>
+#include <cassert>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <vector>
+
+// Allocation counter: every global operator new is routed through here
+static bool counting = false;
+static long allocations = 0;
+
+static void* counted_alloc(std::size_t size) {
+    if (counting) allocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    if (counting) allocations++;
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    if (counting) allocations++;
+    return std::malloc(size ? size : 1);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+// Mixed book: strikes, expiries and vols across regimes, plus a zero-vol contract
+static std::vector<BSContract> make_book(std::size_t n) {
+    std::vector<BSContract> book;
+    for (std::size_t i = 0; i < n; ++i) {
+        BSContract c = {100.0, 70.0 + (i % 61), 0.03, 0.01, 0.05 + 0.01 * (i % 40), 1.0 / 365.0 + 0.05 * (i % 30)};
+        book.push_back(c);
+    }
+    book[n / 2].sigma = 0.0;
+    return book;
+}
+
+void test_no_allocation_in_batch() {
+    std::cout << "Testing batch evaluation performs no allocation... ";
+
+    const std::size_t n = 4096;
+    const std::vector<BSContract> book = make_book(n);
+
+    GreekArena arena;
+    const bool allocated = greek_arena_init(arena, batch_buffer_bytes(n, GREEK_SELECT_ALL));
+    assert(allocated && "Arena should allocate");
+    BatchGreekBuffers out;
+    const bool carved = batch_buffers_from_arena(arena, n, GREEK_SELECT_ALL, out);
+    assert(carved && "Arena should fit all arrays");
+
+    const GreekMethod methods[] = {GREEK_METHOD_ANALYTIC, GREEK_METHOD_COMPLEX_STEP, GREEK_METHOD_FORWARD_DIFF};
+    const unsigned selects[] = {GREEK_SELECT_ALL, GREEK_SELECT_DELTA, GREEK_SELECT_PRICE | GREEK_SELECT_VEGA};
+
+    allocations = 0;
+    counting = true;
+    bool ok = true;
+    bool finite = true;
+    for (int m = 0; m < 3; ++m) {
+        for (int s = 0; s < 3; ++s) {
+            ok = evaluate_greeks_batch(&book[0], n, selects[s], methods[m], 1e-6, out) && ok;
+            if (methods[m] == GREEK_METHOD_ANALYTIC) continue;
+
+            // Numerical results, including the zero-vol contract, must be finite
+            double* const arrays[] = {out.price, out.delta, out.gamma, out.vega};
+            for (int b = 0; b < 4; ++b) {
+                if (!(selects[s] & (1u << b))) continue;
+                for (std::size_t i = 0; i < n; ++i) finite = finite && std::isfinite(arrays[b][i]);
+            }
+        }
+    }
+    counting = false;
+
+    assert(ok && "Batch evaluation should succeed");
+    assert(finite && "Numerical Greeks should be finite for every contract");
+    assert(allocations == 0 && "Batch evaluation must not allocate");
+
+    greek_arena_release(arena);
+    std::cout << "✓ PASSED (" << allocations << " allocations)\n";
+    tests_passed++;
+}
+
+void test_batch_matches_scalar_greeks() {
+    std::cout << "Testing batch results vs scalar functions... ";
+
+    const std::size_t n = 256;
+    const std::vector<BSContract> book = make_book(n);
+
+    // Caller-owned memory attached to the arena
+    static unsigned char storage[4 * 256 * sizeof(double) + 64];
+    GreekArena arena;
+    greek_arena_attach(arena, storage, sizeof(storage));
+    BatchGreekBuffers out;
+    const bool carved = batch_buffers_from_arena(arena, n, GREEK_SELECT_ALL, out);
+    assert(carved && "Attached memory should fit");
+    const bool ran = evaluate_greeks_batch(&book[0], n, GREEK_SELECT_ALL, GREEK_METHOD_ANALYTIC, 0.0, out);
+    assert(ran && "Analytic batch should run");
+
+    double max_error = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const BSContract& c = book[i];
+        max_error = std::max(max_error, std::abs(out.price[i] - bs_price_call(c.S, c.K, c.r, c.q, c.sigma, c.T)));
+        max_error = std::max(max_error, std::abs(out.delta[i] - bs_delta_call(c.S, c.K, c.r, c.q, c.sigma, c.T)));
+        max_error = std::max(max_error, std::abs(out.gamma[i] - bs_gamma_call(c.S, c.K, c.r, c.q, c.sigma, c.T)));
+        max_error = std::max(max_error, std::abs(out.vega[i] - bs_vega_call(c.S, c.K, c.r, c.q, c.sigma, c.T)));
+    }
+    assert(max_error < 1e-12 && "Fused analytic kernel should match scalar Greeks");
+
+    // Complex-step vega against analytic vega
+    greek_arena_reset(arena);
+    const bool recarved = batch_buffers_from_arena(arena, n, GREEK_SELECT_VEGA, out);
+    assert(recarved && "Arena reset should free space");
+    evaluate_greeks_batch(&book[0], n, GREEK_SELECT_VEGA, GREEK_METHOD_COMPLEX_STEP, 1e-8, out);
+    const BSContract& c = book[3];
+    assert(std::abs(out.vega[3] - bs_vega_call(c.S, c.K, c.r, c.q, c.sigma, c.T)) < 1e-10
+           && "Complex-step vega should be nearly exact");
+
+    std::cout << "✓ PASSED (max error = " << std::scientific << max_error << ")\n";
+    tests_passed++;
+}
+
+void test_rejects_bad_buffers() {
+    std::cout << "Testing misaligned and missing buffers are rejected... ";
+
+    const std::vector<BSContract> book = make_book(8);
+    alignas(64) double storage[8 + 1];
+
+    BatchGreekBuffers out = {0, storage + 1, 0, 0};  // Delta buffer off by 8 bytes
+    const bool misaligned = evaluate_greeks_batch(&book[0], 8, GREEK_SELECT_DELTA, GREEK_METHOD_ANALYTIC, 0.0, out);
+    assert(!misaligned && "Misaligned buffer should be rejected");
+    const bool missing = evaluate_greeks_batch(&book[0], 8, GREEK_SELECT_GAMMA, GREEK_METHOD_ANALYTIC, 0.0, out);
+    assert(!missing && "Missing selected buffer should be rejected");
+
+    out.delta = storage;
+    const bool aligned = evaluate_greeks_batch(&book[0], 8, GREEK_SELECT_DELTA, GREEK_METHOD_ANALYTIC, 0.0, out);
+    assert(aligned && "Aligned caller buffer should be accepted");
+
+    // String dispatcher agrees with the direct call
+    const BSContract& c = book[1];
+    assert(bs_analytic_call("delta", c.S, c.K, c.r, c.q, c.sigma, c.T) == out.delta[1]
+           && "String dispatch should match batch delta");
+
+    std::cout << "✓ PASSED\n";
+    tests_passed++;
+}
+
+int main() {
+    std::cout << "\n=== Running Batch Greeks Allocation Tests ===\n\n";
+
+    test_no_allocation_in_batch();
+    test_batch_matches_scalar_greeks();
+    test_rejects_bad_buffers();
+
+    // Summary
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Tests passed: " << tests_passed << "\n";
+    std::cout << "Tests failed: " << tests_failed << "\n";
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ All tests passed!\n\n";
+        return 0;
+    } else {
+        std::cout << "\n✗ Some tests failed!\n\n";
+        return 1;
+    }
+}
@@ -1,10 +1,19 @@
 #include "../bs_call_price_greeks/analytic_greeks.h"
+#include "../bs_call_price/bs_call_price.h"
 #include "../classical_forward_differences/classical_forward_differences.h"
 #include "../complex_step_differentation/complex_step_differentation.h"
+#include "../greek_method_selection/greek_method_selection.h"
+#include "../multicomplex_step/multicomplex_step.h"
+#include "../delta_hedging/delta_hedging.h"
+#include "../volatility_surface/volatility_surface.h"
+#include "../sharded_greeks/sharded_greeks.h"
 #include <iostream>
 #include <cmath>
 #include <cassert>
 #include <iomanip>
+#include <vector>
+#include <cstring>
+#include <limits>
 
 // Test counter
 int tests_passed = 0;
@@ -215,6 +224,434 @@ void test_convergence_fd_to_cs() {
     tests_passed++;
 }
 
+void test_method_selection_meets_target() {
+    std::cout << "Testing regime-based method selection... ";
+    
+    std::vector<double> edges;
+    edges.push_back(1e-3);
+    edges.push_back(0.3);
+    CalibrationTable table;
+    const bool built = build_calibration_table(edges, table);
+    assert(built && "Calibration sweep should succeed");
+    
+    // Empty or descending edges are rejected
+    CalibrationTable rejected;
+    const bool built_empty = build_calibration_table(std::vector<double>(), rejected);
+    std::vector<double> descending(edges.rbegin(), edges.rend());
+    const bool built_descending = build_calibration_table(descending, rejected);
+    assert(!built_empty && !built_descending && "Invalid edges should be rejected");
+    
+    // Scenario 1 and scenario 2 contracts, analytic excluded
+    const BSContract book[] = {{100.0, 100.0, 0.0, 0.0, 0.20, 1.0},
+                               {100.0, 100.0, 0.0, 0.0, 0.01, 1.0 / 365.0},
+                               {100.0, 105.0, 0.0, 0.0, 0.20, 1.0}};
+    const std::size_t n = sizeof(book) / sizeof(book[0]);
+    const unsigned numeric_only = (1u << GREEK_METHOD_COMPLEX_STEP) | (1u << GREEK_METHOD_FORWARD_DIFF);
+    const double target = 1e-6;
+    
+    double delta[n];
+    dispatch_greeks(table, GREEK_DELTA, book, n, target, delta, numeric_only);
+    for (std::size_t i = 0; i < n; ++i) {
+        const BSContract& c = book[i];
+        double error = std::abs(delta[i] - bs_delta_call(c.S, c.K, c.r, c.q, c.sigma, c.T));
+        assert(error <= target && "Dispatched delta should meet the accuracy target");
+    }
+    
+    // Forward differences cannot reach 1e-10 on delta; selection falls back to complex-step
+    const MethodCalibration& tight = select_greek_method(table, GREEK_DELTA, book[1], 1e-10, numeric_only);
+    assert(tight.method == GREEK_METHOD_COMPLEX_STEP && "Tight target should select complex-step");
+    
+    // Restricting to forward differences still yields forward differences
+    const MethodCalibration& fd_only = select_greek_method(table, GREEK_GAMMA, book[0], 1e-12,
+                                                           1u << GREEK_METHOD_FORWARD_DIFF);
+    assert(fd_only.method == GREEK_METHOD_FORWARD_DIFF && "Mask should restrict the choice");
+    
+    std::cout << "✓ PASSED\n";
+    tests_passed++;
+}
+
+void test_method_groups_partition_book() {
+    std::cout << "Testing method groups partition the book... ";
+    
+    std::vector<double> edges;
+    edges.push_back(1e-3);
+    edges.push_back(0.3);
+    CalibrationTable table;
+    const bool built = build_calibration_table(edges, table);
+    assert(built && "Calibration sweep should succeed");
+    
+    // Alternate scenario 1 / scenario 2 contracts, analytic excluded so the regimes pick different steps
+    std::vector<BSContract> book;
+    for (int i = 0; i < 10; ++i) {
+        BSContract c = {100.0, 90.0 + 2.0 * i, 0.0, 0.0, (i % 2) ? 0.01 : 0.20, (i % 2) ? 1.0 / 365.0 : 1.0};
+        book.push_back(c);
+    }
+    const unsigned numeric_only = (1u << GREEK_METHOD_COMPLEX_STEP) | (1u << GREEK_METHOD_FORWARD_DIFF);
+    
+    const std::vector<MethodGroup> groups = group_by_method(table, GREEK_GAMMA, &book[0], book.size(), 1e-6,
+                                                            numeric_only);
+    std::vector<int> seen(book.size(), 0);
+    std::vector<std::size_t> group_of(book.size(), 0);
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        assert(groups[g].method != GREEK_METHOD_ANALYTIC && "Mask should exclude analytic");
+        for (std::size_t i = 0; i < groups[g].indices.size(); ++i) {
+            seen[groups[g].indices[i]]++;
+            group_of[groups[g].indices[i]] = g;
+        }
+    }
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        assert(seen[i] == 1 && "Each contract should belong to exactly one group");
+        assert(group_of[i] == group_of[i % 2] && "Contracts of one regime should share a group");
+    }
+    assert(group_of[0] != group_of[1] && "Scenario 1 and 2 should land in different (method, h_rel) groups");
+    
+    // Dispatch fills every output
+    std::vector<double> gamma(book.size(), std::numeric_limits<double>::quiet_NaN());
+    dispatch_greeks(table, GREEK_GAMMA, &book[0], book.size(), 1e-6, &gamma[0], numeric_only);
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        assert(std::isfinite(gamma[i]) && "dispatch_greeks should fill every output");
+    }
+    
+    std::cout << "✓ PASSED (" << groups.size() << " groups)\n";
+    tests_passed++;
+}
+
+void test_dispatch_outside_calibrated_range() {
+    std::cout << "Testing dispatch for expiring and uncalibrated contracts... ";
+    
+    std::vector<double> edges;
+    edges.push_back(1e-3);
+    edges.push_back(0.3);
+    CalibrationTable table;
+    const bool built = build_calibration_table(edges, table);
+    assert(built && "Calibration sweep should succeed");
+    
+    // Expiring today, σ√T = 2e-7 (below the sampled range), in range, σ√T = 1.8 (above it)
+    const BSContract book[] = {{100.0, 90.0, 0.0, 0.0, 0.2, 0.0},
+                               {100.0, 100.0, 0.0, 0.0, 0.2, 1e-12},
+                               {100.0, 100.0, 0.0, 0.0, 0.2, 1.0},
+                               {100.0, 100.0, 0.0, 0.0, 0.9, 4.0}};
+    const std::size_t n = sizeof(book) / sizeof(book[0]);
+    const bool expect_calibrated[] = {true, false, true, false};
+    const unsigned numeric_only = (1u << GREEK_METHOD_COMPLEX_STEP) | (1u << GREEK_METHOD_FORWARD_DIFF);
+    
+    double delta[n], gamma[n];
+    dispatch_greeks(table, GREEK_DELTA, book, n, 1e-6, delta, numeric_only);
+    const std::vector<MethodGroup> groups = dispatch_greeks(table, GREEK_GAMMA, book, n, 1e-6, gamma, numeric_only);
+    for (std::size_t i = 0; i < n; ++i) {
+        assert(std::isfinite(delta[i]) && std::isfinite(gamma[i]) && "Numeric dispatch should stay finite");
+    }
+    assert(delta[0] == 1.0 && gamma[0] == 0.0 && "Expiring contract should get the closed-form limits");
+    assert(std::abs(book[2].S * (gamma[2] - bs_gamma_call(100.0, 100.0, 0.0, 0.0, 0.2, 1.0))) <= 1e-6
+           && "Calibrated contract should meet the target");
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        for (std::size_t i = 0; i < groups[g].indices.size(); ++i) {
+            assert(groups[g].calibrated == expect_calibrated[groups[g].indices[i]]
+                   && "Groups should report contracts outside the sweep as uncalibrated");
+        }
+    }
+    
+    // With analytic allowed, uncalibrated contracts fall back to it
+    dispatch_greeks(table, GREEK_GAMMA, book, n, 1e-6, gamma);
+    for (std::size_t i = 0; i < n; ++i) {
+        const BSContract& c = book[i];
+        if (!expect_calibrated[i]) {
+            assert(gamma[i] == bs_gamma_call(c.S, c.K, c.r, c.q, c.sigma, c.T)
+                   && "Uncalibrated contract should use the analytic gamma");
+        }
+    }
+    
+    std::cout << "✓ PASSED\n";
+    tests_passed++;
+}
+
+void test_multicomplex_cross_greeks() {
+    std::cout << "Testing multicomplex cross Greeks vs analytic... ";
+    
+    double S = 100.0, K = 105.0, r = 0.05, q = 0.02, sigma = 0.2, T = 1.0;
+    double h = 1e-20;
+    
+    BSCrossGreeks analytic = bs_cross_greeks_call(S, K, r, q, sigma, T);
+    BSCrossGreeks mc = cross_greeks_multicomplex(S, K, r, q, sigma, T, h);
+    
+    const double a[] = {analytic.price, analytic.delta, analytic.vega, analytic.gamma, analytic.vanna,
+                        analytic.volga, analytic.speed, analytic.zomma, analytic.dvanna_dvol, analytic.ultima};
+    const double m[] = {mc.price, mc.delta, mc.vega, mc.gamma, mc.vanna,
+                        mc.volga, mc.speed, mc.zomma, mc.dvanna_dvol, mc.ultima};
+    double max_rel_error = 0.0;
+    for (int i = 0; i < 10; ++i) {
+        max_rel_error = std::max(max_rel_error, std::abs(m[i] - a[i]) / std::abs(a[i]));
+    }
+    assert(max_rel_error < 1e-12 && "Multicomplex cross Greeks should match analytic formulas");
+    
+    std::cout << "✓ PASSED (max rel error = " << std::scientific << max_rel_error << ")\n";
+    tests_passed++;
+}
+
+void test_tricomplex_speed_beats_fd() {
+    std::cout << "Testing tricomplex speed vs nested FD... ";
+    
+    double S = 100.0, K = 100.0, r = 0.05, q = 0.02, sigma = 0.2, T = 1.0;
+    
+    double speed_analytic = bs_cross_greeks_call(S, K, r, q, sigma, T).speed;
+    double speed_mc = speed_multicomplex_step(S, K, r, q, sigma, T, 1e-20);
+    double speed_fd = cross_greeks_fwd(S, K, r, q, sigma, T, 1e-3 * S, 1e-3 * sigma).speed;
+    
+    double error_mc = std::abs(speed_mc - speed_analytic);
+    double error_fd = std::abs(speed_fd - speed_analytic);
+    assert(error_mc < 1e-14 && "Tricomplex speed should be nearly exact");
+    assert(error_mc < error_fd && "Tricomplex speed should beat nested FD");
+    
+    std::cout << "✓ PASSED (error = " << std::scientific << error_mc << ")\n";
+    tests_passed++;
+}
+
+void test_hedging_error_shrinks_with_frequency() {
+    std::cout << "Testing hedging error vs rebalance frequency... ";
+    
+    // One sold ATM call, realized vol equal to implied vol
+    const HedgedOption book[] = {{100.0, 1.0, 0.2, -1.0}};
+    HedgeSimConfig config = default_hedge_config();
+    config.n_paths = 2000;
+    
+    HedgeSimResult daily, weekly;
+    config.rebalance_every = 1;
+    const bool ran_daily = simulate_delta_hedging(config, book, 1, daily);
+    config.rebalance_every = 5;
+    const bool ran_weekly = simulate_delta_hedging(config, book, 1, weekly);
+    assert(ran_daily && ran_weekly && "Daily and weekly simulations should run");
+    
+    assert(daily.stdev < weekly.stdev && "More frequent rebalancing should reduce hedging error");
+    assert(std::abs(daily.mean) < 3.0 * daily.stdev / std::sqrt(2000.0) + 0.02 && "Hedging error should be centred");
+    
+    std::cout << "✓ PASSED (stdev daily = " << std::setprecision(4) << daily.stdev
+              << ", weekly = " << weekly.stdev << ")\n";
+    tests_passed++;
+}
+
+void test_hedging_methods_and_threads_agree() {
+    std::cout << "Testing hedging across delta methods and threads... ";
+    
+    const HedgedOption book[] = {{95.0, 1.0, 0.25, -2.0}, {110.0, 1.5, 0.2, 1.0}};
+    HedgeSimConfig config = default_hedge_config();
+    config.n_paths = 64;
+    config.n_steps = 50;
+    
+    HedgeSimResult analytic, complex_step, threaded;
+    config.n_threads = 1;
+    const bool ran_analytic = simulate_delta_hedging(config, book, 2, analytic);
+    config.n_threads = 3;
+    const bool ran_threaded = simulate_delta_hedging(config, book, 2, threaded);
+    assert(ran_analytic && ran_threaded && "Analytic simulations should run");
+    config.delta_method = GREEK_METHOD_COMPLEX_STEP;
+    config.h_rel = 1e-10;
+    const bool ran_complex_step = simulate_delta_hedging(config, book, 2, complex_step);
+    assert(ran_complex_step && "Complex-step simulation should run");
+    
+    double max_diff = 0.0;
+    for (std::size_t p = 0; p < config.n_paths; ++p) {
+        assert(analytic.pnl[p] == threaded.pnl[p] && "Thread count should not change results");
+        max_diff = std::max(max_diff, std::abs(analytic.pnl[p] - complex_step.pnl[p]));
+    }
+    assert(max_diff < 1e-9 && "Complex-step hedge should match analytic hedge");
+    
+    // Maturity before the horizon is rejected
+    const HedgedOption short_dated[] = {{100.0, 0.5, 0.2, -1.0}};
+    HedgeSimResult rejected;
+    const bool ran_short_dated = simulate_delta_hedging(config, short_dated, 1, rejected);
+    assert(!ran_short_dated && "Invalid book should be rejected");
+    
+    std::cout << "✓ PASSED (max diff = " << std::scientific << max_diff << ")\n";
+    tests_passed++;
+}
+
+void test_flat_surface_matches_scalar_greeks() {
+    std::cout << "Testing flat surface vs scalar Greeks... ";
+    
+    // Flat 20% vol: one spline slice and one SVI slice (b = 0)
+    VolatilitySurface surface;
+    const double k[] = {-0.2, 0.0, 0.2};
+    const double vols[] = {0.2, 0.2, 0.2};
+    const SviParams flat = {0.04 * 2.0, 0.0, 0.0, 0.0, 0.1};
+    const bool spline_set = set_spline_slice(surface, 0.5, k, vols, 3);
+    const bool svi_set = set_svi_slice(surface, 2.0, flat);
+    assert(spline_set && svi_set && "Spline and SVI slices should be accepted");
+    
+    // The last two contracts expire today and take the zero-vol branch
+    BSContract chain[] = {{100.0, 90.0, 0.05, 0.02, 0.0, 0.25},
+                          {100.0, 100.0, 0.05, 0.02, 0.0, 1.0},
+                          {100.0, 120.0, 0.05, 0.02, 0.0, 3.0},
+                          {100.0, 100.0, 0.05, 0.02, 0.0, 0.0},
+                          {100.0, 90.0, 0.05, 0.02, 0.0, 0.0}};
+    double sigma[5], delta[5], vega[5], smile_delta[5];
+    const bool ran = surface_greeks_batch(surface, chain, 5, GREEK_METHOD_ANALYTIC, 0.0,
+                                          sigma, delta, vega, smile_delta);
+    assert(ran && "Surface Greeks should run");
+    
+    for (int i = 0; i < 5; ++i) {
+        const BSContract& c = chain[i];
+        assert(approx_equal(sigma[i], 0.2, 1e-14) && "Flat surface should return 20% vol");
+        assert(approx_equal(delta[i], bs_delta_call(c.S, c.K, c.r, c.q, 0.2, c.T), 1e-14) && "Delta should match");
+        assert(approx_equal(vega[i], bs_vega_call(c.S, c.K, c.r, c.q, 0.2, c.T), 1e-12) && "Vega should match");
+        assert(approx_equal(smile_delta[i], delta[i], 1e-14) && "No smile, no delta adjustment");
+    }
+    
+    // Every delta method gives expiring contracts the intrinsic delta, never NaN
+    const GreekMethod methods[] = {GREEK_METHOD_ANALYTIC, GREEK_METHOD_FORWARD_DIFF, GREEK_METHOD_COMPLEX_STEP};
+    const double h_rels[] = {0.0, 1e-8, 1e-20};
+    for (int m = 0; m < 3; ++m) {
+        BSContract expiring[] = {chain[3], chain[4]};
+        const bool method_ran = surface_greeks_batch(surface, expiring, 2, methods[m], h_rels[m],
+                                                     sigma, delta, vega, smile_delta);
+        assert(method_ran && "Surface Greeks should run for every method");
+        assert(delta[0] == 0.0 && delta[1] == 1.0 && vega[0] == 0.0 && vega[1] == 0.0
+               && smile_delta[0] == 0.0 && smile_delta[1] == 1.0
+               && "Expiring contracts should get intrinsic delta and zero vega");
+    }
+    
+    // An empty surface is rejected without touching the contracts
+    const VolatilitySurface empty = VolatilitySurface();
+    BSContract untouched = chain[0];
+    untouched.sigma = 0.3;
+    const bool applied = apply_surface(empty, &untouched, 1, 0);
+    const bool empty_ran = surface_greeks_batch(empty, &untouched, 1, GREEK_METHOD_ANALYTIC, 0.0,
+                                                sigma, delta, vega, smile_delta);
+    assert(!applied && !empty_ran && untouched.sigma == 0.3 && "Empty surface should be rejected");
+    assert(std::isnan(surface_vol(empty, 0.0, 1.0, 0)) && "Empty surface vol should be NaN");
+    
+    std::cout << "✓ PASSED\n";
+    tests_passed++;
+}
+
+void test_smile_delta_and_slice_update() {
+    std::cout << "Testing smile-adjusted delta and slice update... ";
+    
+    // Skewed spline slices at 3M and 1Y, interpolated in between
+    VolatilitySurface surface;
+    const double k[] = {-0.3, -0.1, 0.0, 0.1, 0.3};
+    const double vols_3m[] = {0.32, 0.25, 0.22, 0.20, 0.19};
+    const double vols_1y[] = {0.28, 0.23, 0.21, 0.195, 0.185};
+    set_spline_slice(surface, 0.25, k, vols_3m, 5);
+    set_spline_slice(surface, 1.0, k, vols_1y, 5);
+    
+    BSContract chain[] = {{100.0, 95.0, 0.03, 0.01, 0.0, 0.6}, {100.0, 100.0, 0.03, 0.01, 0.0, 1.0}};
+    double sigma[2], delta[2], vega[2], smile_delta[2];
+    surface_greeks_batch(surface, chain, 2, GREEK_METHOD_COMPLEX_STEP, 1e-8, sigma, delta, vega, smile_delta);
+    
+    // Smile delta is dC/dS with σ moving along the surface
+    const double dS = 1e-4;
+    BSContract up = chain[0], down = chain[0];
+    up.S += dS;
+    down.S -= dS;
+    apply_surface(surface, &up, 1, 0);
+    apply_surface(surface, &down, 1, 0);
+    const double fd = (bs_price_call(up.S, up.K, up.r, up.q, up.sigma, up.T)
+                       - bs_price_call(down.S, down.K, down.r, down.q, down.sigma, down.T)) / (2.0 * dS);
+    assert(std::abs(smile_delta[0] - fd) < 1e-6 && "Smile delta should match surface-consistent FD");
+    assert(smile_delta[0] > delta[0] && "Sticky-moneyness negative skew should raise the delta");
+    
+    // Recalibrating the 3M slice leaves the 1Y contract untouched
+    const double bumped_3m[] = {0.35, 0.28, 0.25, 0.23, 0.22};
+    set_spline_slice(surface, 0.25, k, bumped_3m, 5);
+    assert(surface.slices.size() == 2 && "Update should replace, not insert");
+    BSContract after[] = {chain[0], chain[1]};
+    apply_surface(surface, after, 2, 0);
+    assert(after[0].sigma > sigma[0] && "Interpolated vol should follow the bumped slice");
+    assert(after[1].sigma == sigma[1] && "Other slice should be unchanged");
+    
+    std::cout << "✓ PASSED (smile delta error = " << std::scientific << std::abs(smile_delta[0] - fd) << ")\n";
+    tests_passed++;
+}
+
+// Book over 3 underliers and 4 expiries, unevenly sized groups
+static std::vector<BookEntry> make_sharding_book(std::size_t n) {
+    const double spots[] = {100.0, 55.0, 230.0};
+    const double expiries[] = {1.0 / 365.0, 0.25, 1.0, 2.0};
+    std::vector<BookEntry> book;
+    for (std::size_t i = 0; i < n; ++i) {
+        const int u = static_cast<int>((i % 7) % 3);
+        const double S = spots[u];
+        BookEntry e = {u, {S, S * (0.8 + 0.01 * (i % 41)), 0.02, 0.01, 0.1 + 0.005 * (i % 50), expiries[(i / 3) % 4]},
+                       (i % 2) ? -1.0 : 2.0};
+        book.push_back(e);
+    }
+    return book;
+}
+
+void test_shards_keep_expiry_groups() {
+    std::cout << "Testing sharding keeps (underlier, expiry) groups together... ";
+    
+    const std::vector<BookEntry> book = make_sharding_book(600);
+    const std::vector<Shard> shards = shard_book(&book[0], book.size(), 4);
+    
+    std::vector<int> owner(book.size(), -1);
+    for (std::size_t s = 0; s < shards.size(); ++s) {
+        for (std::size_t i = 0; i < shards[s].indices.size(); ++i) {
+            assert(owner[shards[s].indices[i]] == -1 && "Contract assigned twice");
+            owner[shards[s].indices[i]] = static_cast<int>(s);
+        }
+    }
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        assert(owner[i] >= 0 && "Contract not assigned");
+        for (std::size_t j = 0; j < i; ++j) {
+            if (book[i].underlier == book[j].underlier && book[i].contract.T == book[j].contract.T) {
+                assert(owner[i] == owner[j] && "Group split across shards");
+            }
+        }
+    }
+    
+    std::cout << "✓ PASSED (" << shards.size() << " shards)\n";
+    tests_passed++;
+}
+
+void test_sharded_matches_single_process() {
+    std::cout << "Testing sharded workers vs single process... ";
+    
+    const std::size_t n = 600;
+    const std::vector<BookEntry> book = make_sharding_book(n);
+    
+    GreekArena arena;
+    const bool allocated = greek_arena_init(arena, 2 * batch_buffer_bytes(n, GREEK_SELECT_ALL));
+    assert(allocated && "Arena should allocate");
+    BatchGreekBuffers local, sharded;
+    batch_buffers_from_arena(arena, n, GREEK_SELECT_ALL, local);
+    batch_buffers_from_arena(arena, n, GREEK_SELECT_ALL, sharded);
+    
+    GreekWorkerPool pool;
+    const bool started = start_worker_pool(pool, 3);
+    assert(started && "Workers should start");
+    
+    const GreekMethod methods[] = {GREEK_METHOD_ANALYTIC, GREEK_METHOD_COMPLEX_STEP};
+    for (int m = 0; m < 2; ++m) {
+        std::vector<UnderlierRisk> risk_local, risk_sharded;
+        const bool ran_local = evaluate_book_local(&book[0], n, GREEK_SELECT_ALL, methods[m], 1e-8,
+                                                   local, risk_local);
+        const bool ran_sharded = evaluate_book_sharded(pool, &book[0], n, GREEK_SELECT_ALL, methods[m], 1e-8,
+                                                       sharded, risk_sharded);
+        assert(ran_local && ran_sharded && "Local and sharded runs should succeed");
+        
+        const std::size_t bytes = n * sizeof(double);
+        assert(std::memcmp(local.price, sharded.price, bytes) == 0 && "Prices should be identical");
+        assert(std::memcmp(local.delta, sharded.delta, bytes) == 0 && "Deltas should be identical");
+        assert(std::memcmp(local.gamma, sharded.gamma, bytes) == 0 && "Gammas should be identical");
+        assert(std::memcmp(local.vega, sharded.vega, bytes) == 0 && "Vegas should be identical");
+        assert(risk_local.size() == 3 && risk_sharded.size() == risk_local.size() && "One risk row per underlier");
+        // Field by field: the padding after the underlier id is unspecified
+        for (std::size_t u = 0; u < risk_local.size(); ++u) {
+            const UnderlierRisk& a = risk_local[u];
+            const UnderlierRisk& b = risk_sharded[u];
+            assert(a.underlier == b.underlier && a.pv == b.pv && a.delta == b.delta && a.gamma == b.gamma
+                   && a.vega == b.vega && "Aggregated risk should be identical");
+        }
+    }
+    
+    stop_worker_pool(pool);
+    greek_arena_release(arena);
+    
+    std::cout << "✓ PASSED\n";
+    tests_passed++;
+}
+
 int main() {
     std::cout << "\n=== Running Black-Scholes Greeks Unit Tests ===\n\n";
     
@@ -236,6 +673,29 @@ int main() {
     test_complex_step_accuracy();
     test_complex_step_gamma_45deg();
     test_convergence_fd_to_cs();
+    test_multicomplex_cross_greeks();
+    test_tricomplex_speed_beats_fd();
+    
+    // Method selection tests
+    std::cout << "\n--- Method Selection Tests ---\n";
+    test_method_selection_meets_target();
+    test_method_groups_partition_book();
+    test_dispatch_outside_calibrated_range();
+    
+    // Delta-hedging simulation tests
+    std::cout << "\n--- Delta Hedging Tests ---\n";
+    test_hedging_error_shrinks_with_frequency();
+    test_hedging_methods_and_threads_agree();
+    
+    // Volatility surface tests
+    std::cout << "\n--- Volatility Surface Tests ---\n";
+    test_flat_surface_matches_scalar_greeks();
+    test_smile_delta_and_slice_update();
+    
+    // Sharded evaluation tests
+    std::cout << "\n--- Sharded Evaluation Tests ---\n";
+    test_shards_keep_expiry_groups();
+    test_sharded_matches_single_process();
     
     // Summary
     std::cout << "\n=== Test Summary ===\n";
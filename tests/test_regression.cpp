@@ -0,0 +1,470 @@
+#include "../write_greeks.h"
+#include "../batch_greeks/batch_greeks.h"
+#include "../greek_method_selection/greek_method_selection.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+// Test counter
+int tests_passed = 0;
+int tests_failed = 0;
+
+// Options (see main)
+static double max_regression_pct = 50.0;
+static bool update_golden = false;
+static bool update_baseline = false;
+
+static const std::string GOLDEN_DIR = "tests/golden/";
+// Untracked scratch directory for the regenerated files, so runs leave
+// the tracked output/ CSVs (which carry machine timings) alone
+static const std::string OUTPUT_DIR = "tests/regression_output/";
+static const std::string PERF_BASELINE = GOLDEN_DIR + "perf_baseline.csv";
+
+// Allowed deviation for one CSV column:
+//   |x - golden| <= abs_tol + rel_tol·|golden| + 16·ε·scale / h^roundoff_order
+// The last term is the rounding error of an order-p difference quotient with
+// step h (taken from the row's "h" column); it only applies for order > 0.
+// A negative order skips the column. Error columns are one-sided: only
+// x - golden is bounded, so a smaller error (e.g. from FMA contraction)
+// never fails.
+struct ColumnTolerance {
+    const char* column;
+    double abs_tol;
+    double rel_tol;
+    int roundoff_order;
+    bool one_sided;
+};
+
+// write_scenario_csv columns
+static const ColumnTolerance SCENARIO_TOLERANCES[] = {
+    {"h_rel", 0.0, 1e-12, 0, false},
+    {"h", 0.0, 1e-12, 0, false},
+    {"Delta_analytic", 1e-15, 1e-12, 0, false},
+    {"Delta_fd", 0.0, 1e-9, 1, false},
+    {"Delta_cs", 1e-12, 1e-12, 0, false},
+    {"err_D_fd", 0.0, 1e-9, 1, true},
+    {"err_D_cs", 1e-12, 0.0, 0, true},
+    {"Gamma_analytic", 1e-15, 1e-12, 0, false},
+    {"Gamma_fd", 0.0, 1e-9, 2, false},
+    {"Gamma_cs_real", 0.0, 1e-9, 2, false},
+    {"Gamma_cs_45", 0.0, 1e-9, 2, false},
+    {"err_G_fd", 0.0, 1e-9, 2, true},
+    {"err_G_cs_real", 0.0, 1e-9, 2, true},
+    {"err_G_cs_45", 0.0, 1e-9, 2, true}
+};
+
+// write_calibration_csv columns. Accuracy is gated on max_err, a roundoff-sized
+// worst case that compiler contraction moves both ways by tens of percent: it
+// fails only if it more than doubles, with a 1e-13 floor for exact methods.
+static const ColumnTolerance CALIBRATION_TOLERANCES[] = {
+    {"greek", 0.0, 0.0, 0, false},
+    {"total_vol_upper", 0.0, 1e-12, 0, false},
+    {"method", 0.0, 0.0, 0, false},
+    {"h_rel", 0.0, 0.0, -1, false},  // Argmin over the step grid; can move a grid point with libm
+    {"max_err", 1e-13, 1.0, 0, true},
+    {"ns_per_eval", 0.0, 0.0, -1, false}
+};
+
+// Columns without an entry must match to 1e-12 relative
+static const ColumnTolerance DEFAULT_TOLERANCE = {"", 0.0, 1e-12, 0, false};
+
+// Rows of comma-separated fields; false if the file cannot be opened
+static bool read_csv_rows(const std::string& path, std::vector<std::vector<std::string> >& rows) {
+    std::ifstream csv(path.c_str());
+    if (!csv.is_open()) return false;
+    rows.clear();
+    std::string line;
+    while (std::getline(csv, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ',')) fields.push_back(field);
+        rows.push_back(fields);
+    }
+    return true;
+}
+
+// Parse a whole field as a double
+static bool parse_number(const std::string& field, double& value) {
+    if (field.empty()) return false;
+    char* end = 0;
+    value = std::strtod(field.c_str(), &end);
+    return *end == '\0';
+}
+
+static const ColumnTolerance& find_tolerance(const std::string& column, const ColumnTolerance* tolerances,
+                                             std::size_t count) {
+    for (std::size_t t = 0; t < count; ++t) {
+        if (column == tolerances[t].column) return tolerances[t];
+    }
+    return DEFAULT_TOLERANCE;
+}
+
+// Compare a regenerated CSV with its golden copy; mismatch descriptions go to failures
+static bool compare_csv(const std::string& output, const std::string& golden,
+                        const ColumnTolerance* tolerances, std::size_t count, double scale,
+                        std::vector<std::string>& failures) {
+    std::vector<std::vector<std::string> > got, want;
+    if (!read_csv_rows(output, got)) {
+        failures.push_back("cannot read " + output);
+        return false;
+    }
+    if (!read_csv_rows(golden, want)) {
+        failures.push_back("cannot read " + golden + " (run with --update-golden to create it)");
+        return false;
+    }
+    if (got.empty() || want.empty() || got[0] != want[0]) {
+        failures.push_back("header of " + output + " differs from " + golden);
+        return false;
+    }
+    if (got.size() != want.size()) {
+        std::ostringstream msg;
+        msg << output << " has " << got.size() - 1 << " rows, golden has " << want.size() - 1;
+        failures.push_back(msg.str());
+        return false;
+    }
+
+    const std::vector<std::string>& header = want[0];
+    const std::size_t h_col = std::find(header.begin(), header.end(), "h") - header.begin();
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    std::size_t mismatches = 0;
+    for (std::size_t r = 1; r < want.size(); ++r) {
+        if (got[r].size() != header.size() || want[r].size() != header.size()) {
+            std::ostringstream msg;
+            msg << output << " row " << r << ": wrong number of fields";
+            failures.push_back(msg.str());
+            return false;
+        }
+        for (std::size_t c = 0; c < header.size(); ++c) {
+            const ColumnTolerance& tol = find_tolerance(header[c], tolerances, count);
+            if (tol.roundoff_order < 0 || got[r][c] == want[r][c]) continue;
+
+            double x, g;
+            bool ok = false;
+            double allowed = 0.0;
+            if (parse_number(got[r][c], x) && parse_number(want[r][c], g)) {
+                allowed = tol.abs_tol + tol.rel_tol * std::abs(g);
+                double h;
+                if (tol.roundoff_order > 0 && h_col < header.size() && parse_number(want[r][h_col], h) && h > 0.0) {
+                    allowed += 16.0 * eps * scale / std::pow(h, tol.roundoff_order);
+                }
+                ok = (tol.one_sided ? x - g : std::abs(x - g)) <= allowed;
+            }
+            if (!ok && ++mismatches <= 5) {
+                std::ostringstream msg;
+                msg << output << " row " << r << " " << header[c] << ": got " << got[r][c]
+                    << ", golden " << want[r][c] << " (allowed " << std::scientific
+                    << std::setprecision(2) << allowed << ")";
+                failures.push_back(msg.str());
+            }
+        }
+    }
+    if (mismatches > 5) {
+        std::ostringstream msg;
+        msg << "... " << mismatches - 5 << " more mismatches";
+        failures.push_back(msg.str());
+    }
+    return mismatches == 0;
+}
+
+// Replace the golden copy with the regenerated file
+static bool copy_file(const std::string& from, const std::string& to) {
+    std::ifstream in(from.c_str(), std::ios::binary);
+    std::ofstream out(to.c_str(), std::ios::binary);
+    if (!in.is_open() || !out.is_open()) {
+        std::cerr << "Error: Could not copy " << from << " to " << to << ".\n";
+        return false;
+    }
+    out << in.rdbuf();
+    return true;
+}
+
+// Swallows the "Written: ..." lines the CSV writers print while in scope
+struct QuietStdout {
+    std::ostringstream sink;
+    std::streambuf* saved;
+    QuietStdout() : saved(std::cout.rdbuf(sink.rdbuf())) {}
+    ~QuietStdout() { std::cout.rdbuf(saved); }
+};
+
+// Pass/fail bookkeeping plus the failure details
+static void report(bool ok, const std::string& note, const std::vector<std::string>& failures) {
+    if (ok) {
+        std::cout << "✓ PASSED" << note << "\n";
+        tests_passed++;
+    } else {
+        std::cout << "✗ FAILED" << note << "\n";
+        tests_failed++;
+    }
+    for (std::size_t i = 0; i < failures.size(); ++i) std::cout << "    " << failures[i] << "\n";
+}
+
+// OUTPUT_DIR/<name> has been regenerated: check or refresh the golden copy
+static void check_golden(const std::string& name, const ColumnTolerance* tolerances, std::size_t count,
+                         double scale) {
+    const std::string output = OUTPUT_DIR + name;
+    const std::string golden = GOLDEN_DIR + name;
+    std::vector<std::string> failures;
+    if (update_golden) {
+        report(copy_file(output, golden), " (golden updated)", failures);
+        return;
+    }
+    report(compare_csv(output, golden, tolerances, count, scale, failures), "", failures);
+}
+
+void test_scenario_golden(int scenario, double S, double K, double r, double q, double sigma, double T) {
+    std::cout << "Testing scenario " << scenario << " sweep against golden file... " << std::flush;
+
+    std::ostringstream name;
+    name << "bs_fd_vs_complex_scenario" << scenario << ".csv";
+    {
+        QuietStdout quiet;
+        write_scenario_csv(OUTPUT_DIR + name.str(), S, K, r, q, sigma, T);
+    }
+    check_golden(name.str(), SCENARIO_TOLERANCES,
+                 sizeof(SCENARIO_TOLERANCES) / sizeof(SCENARIO_TOLERANCES[0]), S);
+}
+
+void test_calibration_golden() {
+    std::cout << "Testing method calibration against golden file... " << std::flush;
+
+    CalibrationTable table;
+    if (!build_calibration_table(default_total_vol_edges(), table)) {
+        report(false, "", std::vector<std::string>(1, "calibration sweep failed"));
+        return;
+    }
+    {
+        QuietStdout quiet;
+        write_calibration_csv(OUTPUT_DIR + "greek_method_calibration.csv", table);
+    }
+    check_golden("greek_method_calibration.csv", CALIBRATION_TOLERANCES,
+                 sizeof(CALIBRATION_TOLERANCES) / sizeof(CALIBRATION_TOLERANCES[0]), 1.0);
+}
+
+// One micro-benchmark measurement
+struct PerfSample {
+    std::string method;
+    std::string greek;
+    double ns_per_contract;
+};
+
+// Machine-speed probe: a plain libm loop with no repo code in it. Its time is
+// stored with the baseline so results can be rescaled across machines and
+// clock-speed changes.
+static volatile double reference_sink;
+static void reference_loop(const BSContract* book, std::size_t n) {
+    double acc = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc += std::exp(-book[i].sigma * book[i].T) * std::log(book[i].K) + std::sqrt(book[i].T);
+    }
+    reference_sink = acc;
+}
+
+// Fixed workload: a 4096-contract book across strikes, expiries and vols.
+// Each (method, Greek) cell and the reference loop is timed over 8 batch
+// passes; the cells are interleaved within each of 15 trials so slow
+// stretches hit all of them, and the best trial is kept.
+static std::vector<PerfSample> run_perf_workload() {
+    const std::size_t n = 4096;
+    const int trials = 15;
+    const int passes = 8;
+
+    std::vector<BSContract> book;
+    for (std::size_t i = 0; i < n; ++i) {
+        BSContract c = {100.0, 70.0 + (i % 61), 0.03, 0.01, 0.05 + 0.01 * (i % 40), 1.0 / 365.0 + 0.05 * (i % 30)};
+        book.push_back(c);
+    }
+
+    GreekArena arena;
+    std::vector<PerfSample> samples;
+    if (!greek_arena_init(arena, batch_buffer_bytes(n, GREEK_SELECT_ALL))) return samples;
+    BatchGreekBuffers out;
+    batch_buffers_from_arena(arena, n, GREEK_SELECT_ALL, out);
+
+    const GreekMethod methods[] = {GREEK_METHOD_ANALYTIC, GREEK_METHOD_COMPLEX_STEP, GREEK_METHOD_FORWARD_DIFF};
+    const char* const method_names[] = {"analytic", "complex_step", "forward_diff"};
+    const unsigned selects[] = {GREEK_SELECT_DELTA, GREEK_SELECT_GAMMA, GREEK_SELECT_VEGA};
+    const char* const greek_names[] = {"delta", "gamma", "vega"};
+    const double h_rel[] = {0.0, 1e-8, 1e-5};
+
+    // Cell 0 is the reference loop, cells 1..9 are (method, Greek)
+    const int cells = 10;
+    std::vector<double> best(cells, std::numeric_limits<double>::infinity());
+    for (int t = 0; t <= trials; ++t) {
+        for (int cell = 0; cell < cells; ++cell) {
+            const int m = (cell - 1) / 3;
+            const int g = (cell - 1) % 3;
+            const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            for (int p = 0; p < passes; ++p) {
+                if (cell == 0) {
+                    reference_loop(&book[0], n);
+                } else {
+                    evaluate_greeks_batch(&book[0], n, selects[g], methods[m], h_rel[m], out);
+                }
+            }
+            const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+            if (t > 0) best[cell] = std::min(best[cell], std::chrono::duration<double, std::nano>(t1 - t0).count());
+        }
+    }
+
+    PerfSample reference = {"reference", "libm", best[0] / (passes * n)};
+    samples.push_back(reference);
+    for (int cell = 1; cell < cells; ++cell) {
+        PerfSample sample = {method_names[(cell - 1) / 3], greek_names[(cell - 1) % 3], best[cell] / (passes * n)};
+        samples.push_back(sample);
+    }
+    greek_arena_release(arena);
+    return samples;
+}
+
+static bool write_perf_baseline(const std::string& path, const std::vector<PerfSample>& samples) {
+    std::ofstream csv(path.c_str());
+    if (!csv.is_open()) {
+        std::cerr << "Error: Could not open " << path << " for writing.\n";
+        return false;
+    }
+    csv << "method,greek,ns_per_contract\n";
+    csv << std::scientific << std::setprecision(6);
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        csv << samples[i].method << "," << samples[i].greek << "," << samples[i].ns_per_contract << "\n";
+    }
+    return true;
+}
+
+// Baseline ns/contract for (method, greek), or 0 if missing
+static double baseline_ns(const std::vector<std::vector<std::string> >& rows, const std::string& method,
+                          const std::string& greek) {
+    double ns = 0.0;
+    for (std::size_t r = 1; r < rows.size(); ++r) {
+        if (rows[r].size() == 3 && rows[r][0] == method && rows[r][1] == greek &&
+            parse_number(rows[r][2], ns) && ns > 0.0) {
+            return ns;
+        }
+    }
+    return 0.0;
+}
+
+void test_perf_regression() {
+    std::cout << "Testing ns/contract against performance baseline (max +" << max_regression_pct
+              << "%)... " << std::flush;
+
+    const std::vector<PerfSample> samples = run_perf_workload();
+    std::vector<std::string> failures;
+    if (samples.empty()) {
+        failures.push_back("could not allocate the benchmark arena");
+        report(false, "", failures);
+        return;
+    }
+    if (update_baseline) {
+        report(write_perf_baseline(PERF_BASELINE, samples), " (baseline updated)", failures);
+        return;
+    }
+
+    std::vector<std::vector<std::string> > rows;
+    if (!read_csv_rows(PERF_BASELINE, rows)) {
+        failures.push_back("cannot read " + PERF_BASELINE + " (run with --update-baseline to create it)");
+        report(false, "", failures);
+        return;
+    }
+
+    // Rescale the baseline by how fast this machine runs the reference loop
+    const double reference = baseline_ns(rows, "reference", "libm");
+    const double speed = reference > 0.0 ? samples[0].ns_per_contract / reference : 1.0;
+
+    bool ok = true;
+    std::vector<std::string> lines;
+    std::ostringstream header;
+    header << std::fixed << std::setprecision(2) << "machine speed factor " << speed
+           << (reference > 0.0 ? "" : " (no reference row in baseline)");
+    lines.push_back(header.str());
+
+    for (std::size_t i = 1; i < samples.size(); ++i) {
+        const PerfSample& s = samples[i];
+        const double baseline = baseline_ns(rows, s.method, s.greek) * speed;
+
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(1) << std::left << std::setw(13) << s.method
+             << std::setw(6) << s.greek << std::right << std::setw(9) << s.ns_per_contract << " ns";
+        if (baseline == 0.0) {
+            line << "  no baseline entry";
+            ok = false;
+        } else {
+            const double change = 100.0 * (s.ns_per_contract / baseline - 1.0);
+            line << "  (baseline " << baseline << " ns, " << std::showpos << change << std::noshowpos << "%)";
+            if (change > max_regression_pct) {
+                line << "  REGRESSION";
+                ok = false;
+            }
+        }
+        lines.push_back(line.str());
+    }
+    report(ok, "", lines);
+}
+
+int main(int argc, char** argv) {
+    /**
+     * Golden-accuracy and performance regression suite. Run from the
+     * repository root, built with -O2 (the baseline is recorded that way):
+     *
+     *   --max-regression=PCT  allowed ns/contract increase over the baseline
+     *                         (default 50, or $GREEKS_MAX_REGRESSION)
+     *   --update-golden       replace the golden CSVs in tests/golden/ with the regenerated outputs
+     *   --update-baseline     re-record tests/golden/perf_baseline.csv on this machine
+     */
+    if (const char* env = std::getenv("GREEKS_MAX_REGRESSION")) max_regression_pct = std::atof(env);
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const std::string regression_flag = "--max-regression=";
+        if (arg == "--update-golden") {
+            update_golden = true;
+        } else if (arg == "--update-baseline") {
+            update_baseline = true;
+        } else if (arg.compare(0, regression_flag.size(), regression_flag) == 0) {
+            max_regression_pct = std::atof(arg.c_str() + regression_flag.size());
+        } else {
+            std::cerr << "Error: Unknown option " << arg << ".\n"
+                      << "Usage: " << argv[0] << " [--max-regression=PCT] [--update-golden] [--update-baseline]\n";
+            return 2;
+        }
+    }
+
+    if (mkdir(OUTPUT_DIR.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cerr << "Error: Could not create " << OUTPUT_DIR << ".\n";
+        return 1;
+    }
+
+    std::cout << "\n=== Running Golden Accuracy and Performance Regression Tests ===\n\n";
+
+    std::cout << "--- Golden Output Tests ---\n";
+    test_scenario_golden(1, 100.0, 100.0, 0.0, 0.0, 0.20, 1.0);
+    test_scenario_golden(2, 100.0, 100.0, 0.0, 0.0, 0.01, 1.0 / 365.0);
+    test_calibration_golden();
+
+    std::cout << "\n--- Performance Regression Tests ---\n";
+    test_perf_regression();
+
+    // Summary
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Tests passed: " << tests_passed << "\n";
+    std::cout << "Tests failed: " << tests_failed << "\n";
+
+    if (tests_failed == 0) {
+        std::cout << "\n✓ All tests passed!\n\n";
+        return 0;
+    } else {
+        std::cout << "\n✗ Some tests failed!\n\n";
+        return 1;
+    }
+}
@@ -0,0 +1,250 @@
+#include "volatility_surface.h"
+#include "../bs_call_price_greeks/analytic_greeks.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+// Slot for expiry T: the existing slice with that T, or a new one inserted in order
+static VolSlice& slice_slot(VolatilitySurface& surface, double T) {
+    std::vector<VolSlice>::iterator it = surface.slices.begin();
+    while (it != surface.slices.end() && it->T < T) ++it;
+    if (it != surface.slices.end() && it->T == T) return *it;
+
+    VolSlice slice;
+    slice.T = T;
+    slice.kind = VOL_SLICE_SPLINE;
+    SviParams flat = {0.0, 0.0, 0.0, 0.0, 0.0};
+    slice.svi = flat;
+    return *surface.slices.insert(it, slice);
+}
+
+// Natural cubic spline second derivatives through (k, w)
+static void compute_spline_coefficients(VolSlice& slice) {
+    const std::size_t n = slice.k.size();
+    slice.w2.assign(n, 0.0);
+    if (n < 3) return;
+
+    std::vector<double> u(n, 0.0);
+    for (std::size_t i = 1; i + 1 < n; ++i) {
+        const double sig = (slice.k[i] - slice.k[i - 1]) / (slice.k[i + 1] - slice.k[i - 1]);
+        const double p = sig * slice.w2[i - 1] + 2.0;
+        slice.w2[i] = (sig - 1.0) / p;
+        const double slope_right = (slice.w[i + 1] - slice.w[i]) / (slice.k[i + 1] - slice.k[i]);
+        const double slope_left = (slice.w[i] - slice.w[i - 1]) / (slice.k[i] - slice.k[i - 1]);
+        u[i] = (6.0 * (slope_right - slope_left) / (slice.k[i + 1] - slice.k[i - 1]) - sig * u[i - 1]) / p;
+    }
+    for (std::size_t i = n - 1; i-- > 0;) {
+        slice.w2[i] = slice.w2[i] * slice.w2[i + 1] + u[i];
+    }
+}
+
+bool set_spline_slice(VolatilitySurface& surface, double T, const double* k, const double* vols,
+                      std::size_t n) {
+    /**
+     * Sets the slice at expiry T from implied vols at log-moneyness nodes.
+     * Only this slice's spline coefficients are recomputed.
+     *
+     * @param surface Surface to update
+     * @param T       Slice expiry (> 0)
+     * @param k       Log-moneyness nodes log(K/F), strictly ascending
+     * @param vols    Implied vols at the nodes (> 0)
+     * @param n       Number of nodes (>= 1)
+     * @return        false if the inputs are invalid
+     */
+    if (!(T > 0.0) || n == 0) {
+        std::cerr << "Error: Spline slice needs T > 0 and at least one node.\n";
+        return false;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!(vols[i] > 0.0) || (i > 0 && !(k[i] > k[i - 1]))) {
+            std::cerr << "Error: Spline slice nodes must be ascending with positive vols.\n";
+            return false;
+        }
+    }
+
+    VolSlice& slice = slice_slot(surface, T);
+    slice.kind = VOL_SLICE_SPLINE;
+    slice.k.assign(k, k + n);
+    slice.w.resize(n);
+    for (std::size_t i = 0; i < n; ++i) slice.w[i] = vols[i] * vols[i] * T;
+    compute_spline_coefficients(slice);
+    return true;
+}
+
+bool set_svi_slice(VolatilitySurface& surface, double T, const SviParams& params) {
+    /**
+     * Sets the slice at expiry T to an SVI parameterization. The parameters
+     * are the slice's coefficients; nothing else is cached.
+     */
+    if (!(T > 0.0) || params.b < 0.0 || std::abs(params.rho) >= 1.0 || !(params.s > 0.0) ||
+        params.a + params.b * params.s * std::sqrt(1.0 - params.rho * params.rho) <= 0.0) {
+        std::cerr << "Error: SVI slice needs T > 0, b >= 0, |rho| < 1, s > 0 and positive variance.\n";
+        return false;
+    }
+
+    VolSlice& slice = slice_slot(surface, T);
+    slice.kind = VOL_SLICE_SVI;
+    slice.svi = params;
+    slice.k.clear();
+    slice.w.clear();
+    slice.w2.clear();
+    return true;
+}
+
+double slice_total_variance(const VolSlice& slice, double k, double* dw_dk) {
+    if (slice.kind == VOL_SLICE_SVI) {
+        const SviParams& p = slice.svi;
+        const double x = k - p.m;
+        const double root = std::sqrt(x * x + p.s * p.s);
+        if (dw_dk) *dw_dk = p.b * (p.rho + x / root);
+        return p.a + p.b * (p.rho * x + root);
+    }
+
+    // Flat total variance outside the nodes
+    const std::size_t n = slice.k.size();
+    if (n == 1 || k <= slice.k[0] || k >= slice.k[n - 1]) {
+        if (dw_dk) *dw_dk = 0.0;
+        return (n == 1 || k <= slice.k[0]) ? slice.w[0] : slice.w[n - 1];
+    }
+
+    const std::size_t hi = std::upper_bound(slice.k.begin(), slice.k.end(), k) - slice.k.begin();
+    const std::size_t lo = hi - 1;
+    const double h = slice.k[hi] - slice.k[lo];
+    const double A = (slice.k[hi] - k) / h;
+    const double B = 1.0 - A;
+
+    if (dw_dk) {
+        *dw_dk = (slice.w[hi] - slice.w[lo]) / h
+                 - (3.0 * A * A - 1.0) / 6.0 * h * slice.w2[lo]
+                 + (3.0 * B * B - 1.0) / 6.0 * h * slice.w2[hi];
+    }
+    return A * slice.w[lo] + B * slice.w[hi]
+           + ((A * A * A - A) * slice.w2[lo] + (B * B * B - B) * slice.w2[hi]) * (h * h) / 6.0;
+}
+
+// Slices bracketing T: lo == hi outside the slice range. Requires a non-empty surface.
+static void bracket_expiry(const VolatilitySurface& surface, double T, std::size_t& lo, std::size_t& hi) {
+    const std::size_t n = surface.slices.size();
+    if (T <= surface.slices[0].T) {
+        lo = hi = 0;
+        return;
+    }
+    if (T >= surface.slices[n - 1].T) {
+        lo = hi = n - 1;
+        return;
+    }
+    hi = 1;
+    while (surface.slices[hi].T < T) ++hi;
+    lo = (surface.slices[hi].T == T) ? hi : hi - 1;
+}
+
+// Vol at (k, T) from a known bracket; linear in total variance between slices
+static double bracketed_vol(const VolatilitySurface& surface, std::size_t lo, std::size_t hi,
+                            double k, double T, double* dsigma_dk) {
+    const VolSlice& s_lo = surface.slices[lo];
+    double dw_lo = 0.0;
+    const double w_lo = slice_total_variance(s_lo, k, &dw_lo);
+
+    // Expiring contracts: σ√T = 0 whatever σ is, so report the nearest
+    // slice's vol with no smile slope instead of dividing 0 by 0
+    if (T <= 0.0) {
+        if (dsigma_dk) *dsigma_dk = 0.0;
+        return std::sqrt(std::max(w_lo, 0.0) / s_lo.T);
+    }
+
+    double w, dw_dk;
+    if (lo == hi) {
+        // Flat implied vol in T beyond the slice range
+        w = w_lo * T / s_lo.T;
+        dw_dk = dw_lo * T / s_lo.T;
+    } else {
+        const VolSlice& s_hi = surface.slices[hi];
+        double dw_hi = 0.0;
+        const double w_hi = slice_total_variance(s_hi, k, &dw_hi);
+        const double x = (T - s_lo.T) / (s_hi.T - s_lo.T);
+        w = w_lo + x * (w_hi - w_lo);
+        dw_dk = dw_lo + x * (dw_hi - dw_lo);
+    }
+
+    const double sigma = std::sqrt(std::max(w, 0.0) / T);
+    if (dsigma_dk) *dsigma_dk = (sigma > 0.0) ? dw_dk / (2.0 * sigma * T) : 0.0;
+    return sigma;
+}
+
+double surface_vol(const VolatilitySurface& surface, double k, double T, double* dsigma_dk) {
+    /**
+     * Implied vol at log-moneyness k and expiry T. For T <= 0 this is the
+     * first slice's vol at k, with dσ/dk = 0.
+     *
+     * @return NaN (and NaN dσ/dk) if the surface has no slices
+     */
+    if (surface.slices.empty()) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        if (dsigma_dk) *dsigma_dk = nan;
+        return nan;
+    }
+
+    std::size_t lo, hi;
+    bracket_expiry(surface, T, lo, hi);
+    return bracketed_vol(surface, lo, hi, k, T, dsigma_dk);
+}
+
+bool apply_surface(const VolatilitySurface& surface, BSContract* contracts, std::size_t n,
+                   double* dsigma_dS) {
+    /**
+     * Batch lookup. The expiry bracket is reused while consecutive contracts
+     * share T, so a chain sorted by expiry searches the slices once per
+     * expiry; each slice evaluation uses the cached coefficients.
+     *
+     * @return false, leaving the contracts untouched, if the surface has no slices
+     */
+    if (surface.slices.empty()) {
+        std::cerr << "Error: Volatility surface has no slices.\n";
+        return false;
+    }
+
+    double last_T = -1.0;
+    std::size_t lo = 0, hi = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        BSContract& c = contracts[i];
+        if (c.T != last_T) {
+            bracket_expiry(surface, c.T, lo, hi);
+            last_T = c.T;
+        }
+
+        const double F = c.S * std::exp((c.r - c.q) * c.T);
+        const double k = std::log(c.K / F);
+        double dsigma_dk = 0.0;
+        c.sigma = bracketed_vol(surface, lo, hi, k, c.T, &dsigma_dk);
+
+        // k = log(K/F) with F ∝ S, so dk/dS = -1/S
+        if (dsigma_dS) dsigma_dS[i] = -dsigma_dk / c.S;
+    }
+    return true;
+}
+
+bool surface_greeks_batch(const VolatilitySurface& surface, BSContract* contracts, std::size_t n,
+                          GreekMethod method, double h_rel,
+                          double* sigma, double* delta, double* vega, double* smile_delta) {
+    /**
+     * Prices a chain off the surface with the batch Greek API:
+     *   σ_i       from apply_surface (written back into contracts[i].sigma)
+     *   Δ_i       from evaluate_greek_batch with the chosen method
+     *   ν_i       analytic vega at σ_i
+     *   Δ_smile_i = Δ_i + ν_i dσ/dS (sticky-moneyness)
+     * smile_delta doubles as scratch for dσ/dS, so no buffers are allocated.
+     *
+     * @return false if the surface has no slices
+     */
+    if (!apply_surface(surface, contracts, n, smile_delta)) return false;
+    evaluate_greek_batch(GREEK_DELTA, method, h_rel, contracts, 0, n, delta);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const BSContract& c = contracts[i];
+        sigma[i] = c.sigma;
+        vega[i] = bs_vega_call(c.S, c.K, c.r, c.q, c.sigma, c.T);
+        smile_delta[i] = delta[i] + vega[i] * smile_delta[i];
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file volatility_surface.h
+ * @brief Implied volatility surface feeding the batch Greek API
+ *
+ * The surface is a set of expiry slices, each giving total implied
+ * variance w(k) = σ²T as a function of log-moneyness k = log(K/F), with
+ * F = S e^{(r-q)T}. A slice is either a natural cubic spline through market
+ * nodes or an SVI parameterization. Spline coefficients are cached per
+ * slice and recomputed only for the slice that changes.
+ *
+ * Between slices, total variance is interpolated linearly in T at fixed k;
+ * beyond the first/last slice the slice's implied vol is held flat in T.
+ * Expiring contracts (T <= 0) take the first slice's vol with no smile slope.
+ */
+
+#ifndef VOLATILITY_SURFACE_H
+#define VOLATILITY_SURFACE_H
+
+#include "../greek_method_selection/greek_method_selection.h"
+#include <cstddef>
+#include <vector>
+
+// Slice representation
+enum VolSliceKind {
+    VOL_SLICE_SPLINE = 0,
+    VOL_SLICE_SVI = 1
+};
+
+// Raw SVI: w(k) = a + b (ρ (k - m) + sqrt((k - m)² + s²))
+struct SviParams {
+    double a;
+    double b;
+    double rho;
+    double m;
+    double s;
+};
+
+// One expiry slice with its cached interpolation coefficients
+struct VolSlice {
+    double T;
+    VolSliceKind kind;
+    std::vector<double> k;    // Spline nodes in log-moneyness (ascending)
+    std::vector<double> w;    // Total variance at the nodes
+    std::vector<double> w2;   // Cached spline second derivatives
+    SviParams svi;
+};
+
+// Slices kept sorted by expiry
+struct VolatilitySurface {
+    std::vector<VolSlice> slices;
+};
+
+// Insert or replace (same T) a spline slice from implied vols at log-moneyness nodes
+bool set_spline_slice(VolatilitySurface& surface, double T, const double* k, const double* vols,
+                      std::size_t n);
+
+// Insert or replace (same T) an SVI slice
+bool set_svi_slice(VolatilitySurface& surface, double T, const SviParams& params);
+
+// Total variance of one slice at log-moneyness k, and optionally dw/dk
+double slice_total_variance(const VolSlice& slice, double k, double* dw_dk);
+
+// Implied vol at (k, T), and optionally dσ/dk; NaN if the surface has no slices
+double surface_vol(const VolatilitySurface& surface, double k, double T, double* dsigma_dk);
+
+// Fill contracts[i].sigma from the surface; dsigma_dS (optional) receives the
+// sticky-moneyness smile slope dσ/dS = -(dσ/dk) / S. False if the surface has no slices.
+bool apply_surface(const VolatilitySurface& surface, BSContract* contracts, std::size_t n,
+                   double* dsigma_dS);
+
+// Smile-consistent batch Greeks: surface vol, delta by the chosen method,
+// analytic vega and smile-adjusted delta Δ + ν dσ/dS. Output arrays have n entries.
+bool surface_greeks_batch(const VolatilitySurface& surface, BSContract* contracts, std::size_t n,
+                          GreekMethod method, double h_rel,
+                          double* sigma, double* delta, double* vega, double* smile_delta);
+
+#endif // VOLATILITY_SURFACE_H